@@ -1,15 +1,67 @@
 #include <iostream>
+#include <fstream>
 #include <memory> 
 #include <iomanip>
 
 #include "edp/Interface.h"
 #include "edp/PDESolver.h"
 #include "edp/Payoff.h"
+#include "edp/Richardson.h"
+#include "edp/GridSizing.h"
+#include "edp/BatchPricer.h"
 
-int main() {
+// Mode batch : portefeuille projeté en mémoire, résultats écrits au fil de l'eau
+static int runBatch(const edp::Interface& ui) {
+    edp::MappedFile file(ui.getBatchInput());
+    edp::ContractReader reader(file);
+
+    edp::BatchOptions options;
+    options.threads = ui.getBatchThreads();
+    options.sensitivities = ui.getBatchSensitivities();
+
+    edp::BatchStats stats;
+    if (ui.getBatchOutput().empty()) {
+        stats = edp::priceBatch(reader, std::cout, options);
+    } else {
+        std::ofstream out(ui.getBatchOutput());
+        if (!out) {
+            std::cerr << "ERREUR FATALE : impossible d'ecrire " << ui.getBatchOutput() << std::endl;
+            return 1;
+        }
+        stats = edp::priceBatch(reader, out, options);
+    }
+
+    std::cerr << std::fixed << std::setprecision(3)
+              << "Contrats : " << stats.contracts << " (echecs : " << stats.failed
+              << ", tolerance non atteinte : " << stats.unachieved << ") en "
+              << stats.seconds << " s, " << std::setprecision(1)
+              << stats.contractsPerSecond() << " contrats/s" << std::endl;
+
+    // Statistiques agrégées des solveurs (nulles sans EDP_ENABLE_STATS)
+    if (!ui.getBatchStats().empty()) {
+        std::ofstream stats_out(ui.getBatchStats());
+        if (!stats_out) {
+            std::cerr << "ERREUR FATALE : impossible d'ecrire " << ui.getBatchStats() << std::endl;
+            return 1;
+        }
+        if (!edp::SolveStats::enabled) {
+            std::cerr << "Avertissement : statistiques non collectees (compiler avec -DEDP_ENABLE_STATS=ON)"
+                      << std::endl;
+        }
+        stats.solver.writeCsv(stats_out);
+    }
+    return stats.failed == 0 ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
     try {
         // 1. Initialisation de l'interface
         edp::Interface ui;
+
+        // Mode batch demandé en ligne de commande : aucune saisie interactive
+        if (ui.parseCommandLine(argc, argv)) {
+            return runBatch(ui);
+        }
         
         // 2. Demande du mode d'exécution
         ui.askRunMode();
@@ -38,17 +90,63 @@ int main() {
             payoff = std::make_unique<edp::PayoffPut>(ui.getK());
         }
 
+        // Domaine automatique (S_max = 0) : bornes à 5 écarts-types autour du forward.
+        // Avec une précision cible, N et M viennent du modèle d'erreur (un seul solve).
+        const bool autoDomain = !(ui.getS_max() > 0.0);
+        edp::GridChoice grid;
+        if (autoDomain) {
+            if (ui.getTolerance() > 0.0) {
+                grid = edp::chooseGrid(ui.getS0(), ui.getK(), ui.getT(), ui.getR(), ui.getSigma(),
+                                       ui.getTolerance());
+            } else {
+                grid = edp::chooseDomain(ui.getS0(), ui.getK(), ui.getT(), ui.getR(), ui.getSigma(), ui.getN());
+                grid.M = ui.getM();
+            }
+        }
+
+        // Mode précision cible : N et M choisis par raffinements successifs
+        if (!autoDomain && ui.getTolerance() > 0.0) {
+            edp::ToleranceOptions options;
+            options.S_center = ui.getK();
+
+            edp::ToleranceResult tol = edp::solveToTolerance(
+                *payoff, ui.getS0(), ui.getT(), ui.getR(), ui.getSigma(),
+                ui.getS_max(), ui.getThetaScheme(), ui.getTolerance(), options);
+
+            std::cout << ">>> RESULTATS (Richardson) <<<" << std::endl;
+            std::cout << "-----------------------------" << std::endl;
+            std::cout << std::fixed << std::setprecision(5);
+            std::cout << "Prix de l'option : " << tol.results.price << std::endl;
+            std::cout << "Erreur estimee   : " << std::scientific << tol.error_estimate << std::fixed << std::endl;
+            std::cout << "Delta            : " << tol.results.delta << std::endl;
+            std::cout << "Gamma            : " << tol.results.gamma << std::endl;
+            std::cout << "Theta            : " << tol.results.theta << std::endl;
+            std::cout << "Grille utilisee  : N = " << tol.N << ", M = " << tol.M
+                      << " (" << tol.levels << " niveaux)" << std::endl;
+            if (!tol.converged) {
+                std::cout << "ATTENTION : precision cible non atteinte." << std::endl;
+            }
+            return 0;
+        }
+
         // Initialisation du Solver
         
         edp::PDESolver solver(
             ui.getT(),
             ui.getR(),
             ui.getSigma(),
-            ui.getS_max(),
+            autoDomain ? grid.S_max : ui.getS_max(),
             ui.getThetaScheme(), // 0.5 = CN, 1.0 = Implicite
-            ui.getN(),
-            ui.getM()
+            autoDomain ? grid.N : ui.getN(),
+            autoDomain ? grid.M : ui.getM()
         );
+        if (autoDomain) {
+            solver.setDomain(grid.S_min, grid.S_max);
+            solver.setRannacherSteps(grid.rannacher_steps);
+        }
+
+        // Vega et Rho par équations tangentes, dans la même remontée en temps
+        solver.setComputeSensitivities(true);
 
         // Lancement du Pricing
         
@@ -61,7 +159,20 @@ int main() {
         std::cout << "Prix de l'option : " << res.price << std::endl;
         std::cout << "Delta            : " << res.delta << std::endl;
         std::cout << "Gamma            : " << res.gamma << std::endl;
+        std::cout << "Theta            : " << res.theta << std::endl;
+        std::cout << "Vega             : " << res.vega << std::endl;
+        std::cout << "Rho              : " << res.rho << std::endl;
         std::cout << "Theta (Schema)   : " << ui.getThetaScheme() << std::endl;
+        if (autoDomain) {
+            std::cout << "Grille utilisee  : S dans [" << grid.S_min << ", " << grid.S_max
+                      << "], N = " << grid.N << ", M = " << grid.M << std::endl;
+            if (ui.getTolerance() > 0.0) {
+                std::cout << "Erreur estimee   : " << std::scientific << grid.estimated_error << std::fixed << std::endl;
+                if (!grid.achievable) {
+                    std::cout << "ATTENTION : precision cible non atteinte (grille plafonnee)." << std::endl;
+                }
+            }
+        }
 
     } catch (const std::exception& e) {
         std::cerr << "ERREUR FATALE : " << e.what() << std::endl;
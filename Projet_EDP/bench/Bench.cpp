@@ -0,0 +1,808 @@
+/*
+ * EDP_Bench : suite de benchmarks du projet.
+ *
+ *   EDP_Bench [--quick] [--filter motif] [--samples n] [--output run.json]
+ *             [--baseline reference.json] [--tolerance 0.10]
+ *
+ * Suites :
+ *   noyaux     thomas/ (algorithme de Thomas), factorized/ et partitioned/ (même matrice
+ *              factorisée, descente séquentielle ou partitionnée multi-thread),
+ *              thomas_batch/ (systèmes entrelacés par niveau SIMD, contre une boucle
+ *              scalaire), projected/ (obstacle : Brennan-Schwartz contre PSOR) ;
+ *   solveur    solve/ (PDESolver::solve), setup/ (construction + matrices, avec et
+ *              sans cache), batch/ (solve par lot en double, float et mixte),
+ *              ladder/ (échelle de spots : solves individuels contre une tranche),
+ *              american/ (Brennan-Schwartz contre PSOR), local_vol/ (sigma constant
+ *              contre surface), tolerance/ (Richardson contre une grille fine),
+ *              heston/ (ADI par nombre de threads) ;
+ *   moteurs    batch_pricer/ (CSV et binaire), engine/ (PricingEngine par nombre de
+ *              workers), scenario/ (ScenarioEngine contre un solve par choc de vol),
+ *              black_scholes/ (formule fermée en n spots), implied_vol/ (ImpliedVolSolver
+ *              sur une nappe de cotations).
+ * Chaque benchmark fait des tours de chauffe, puis des échantillons chronométrés
+ * (chacun répète l'appel assez de fois pour durer environ une milliseconde).
+ * Le JSON donne médiane, p99 et minimum par appel, le temps par noeud et par pas,
+ * et pour batch/ l'écart de prix au double (error).
+ * Avec --baseline, chaque médiane est comparée à la référence : le programme
+ * renvoie 1 si l'une d'elles dépasse la référence de plus de la tolérance.
+ */
+#include "edp/LinearSolver.h"
+#include "edp/PDESolver.h"
+#include "edp/Payoff.h"
+#include "edp/Richardson.h"
+#include "edp/HestonSolver.h"
+#include "edp/BatchPricer.h"
+#include "edp/PricingEngine.h"
+#include "edp/ScenarioEngine.h"
+#include "edp/ImpliedVol.h"
+#include "edp/BlackScholes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    struct Options {
+        bool quick = false;
+        std::string filter;
+        size_t samples = 31;
+        std::string output;      // Vide : JSON sur la sortie standard
+        std::string baseline;
+        double tolerance = 0.10; // Dégradation relative admise de la médiane
+    };
+
+    struct Result {
+        std::string name;
+        size_t samples = 0;
+        size_t iterations = 0;      // Appels par échantillon
+        double median_ns = 0.0;     // Par appel
+        double p99_ns = 0.0;
+        double min_ns = 0.0;
+        double ns_per_node_step = 0.0;
+        double error = -1.0;        // Écart maximal à la référence (< 0 : sans objet)
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    // Percentile par rang le plus proche sur des échantillons triés
+    double percentile(const std::vector<double>& sorted, double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+        return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+    }
+
+    // work : nombre de (noeuds x pas) d'un appel, pour le temps normalisé
+    Result measure(const std::string& name, double work, const Options& opt,
+                   const std::function<void()>& call) {
+        // Chauffe : caches, opérateurs, espaces de travail ; calibre les répétitions
+        auto t0 = Clock::now();
+        size_t warm = 0;
+        while (warm < 3 || Clock::now() - t0 < std::chrono::milliseconds(20)) {
+            call();
+            ++warm;
+        }
+        double per_call = std::chrono::duration<double, std::nano>(Clock::now() - t0).count()
+                        / static_cast<double>(warm);
+        size_t iterations = std::max<size_t>(1, static_cast<size_t>(1e6 / std::max(per_call, 1.0)));
+
+        std::vector<double> times(opt.samples);
+        for (double& t : times) {
+            auto start = Clock::now();
+            for (size_t k = 0; k < iterations; ++k) call();
+            t = std::chrono::duration<double, std::nano>(Clock::now() - start).count()
+              / static_cast<double>(iterations);
+        }
+        std::sort(times.begin(), times.end());
+
+        Result r;
+        r.name = name;
+        r.samples = times.size();
+        r.iterations = iterations;
+        r.median_ns = percentile(times, 0.5);
+        r.p99_ns = percentile(times, 0.99);
+        r.min_ns = times.front();
+        r.ns_per_node_step = r.median_ns / work;
+        return r;
+    }
+
+    bool selected(const std::string& name, const Options& opt) {
+        return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+    }
+
+    // --- Benchmarks ---
+
+    // Système tridiagonal à diagonale dominante (celui d'un pas de Crank-Nicolson)
+    void benchThomas(const Options& opt, std::vector<Result>& results) {
+        std::vector<size_t> sizes = {100, 1000, 10000, 100000, 1000000};
+        if (opt.quick) sizes.resize(3);
+
+        for (size_t n : sizes) {
+            std::string name = "thomas/n=" + std::to_string(n);
+            if (!selected(name, opt)) continue;
+
+            std::vector<double> a(n, -1.0), b(n, 4.0), c(n, -1.0), d(n), x(n);
+            for (size_t i = 0; i < n; ++i) d[i] = std::sin(0.001 * static_cast<double>(i));
+            edp::ThomasWorkspace ws;
+            results.push_back(measure(name, static_cast<double>(n), opt, [&] {
+                edp::thomasAlgorithm(a, b, c, d, x, ws);
+            }));
+        }
+    }
+
+    // Solveur partitionné (threads permanents) sur le même système, au-delà du seuil
+    // de PDESolver (100 000 inconnues) : à comparer à factorized/n= (même A factorisée,
+    // descente/remontée séquentielle), le chemin de PDESolver sous le seuil.
+    // Au moins 2 threads, pour mesurer le chemin parallèle même sur une machine à un cœur.
+    void benchPartitioned(const Options& opt, std::vector<Result>& results) {
+        std::vector<size_t> sizes = {10000, 100000, 1000000};
+        if (opt.quick) sizes.resize(1);
+        const unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+
+        for (size_t n : sizes) {
+            std::string name = "partitioned/n=" + std::to_string(n) + ",threads=" + std::to_string(threads);
+            if (!selected(name, opt)) continue;
+
+            std::vector<double> a(n, -1.0), b(n, 4.0), c(n, -1.0), d(n), x(n);
+            for (size_t i = 0; i < n; ++i) d[i] = std::sin(0.001 * static_cast<double>(i));
+            edp::PartitionedTridiagonalSolver solver;
+            solver.factorize(a, b, c, threads);
+            results.push_back(measure(name, static_cast<double>(n), opt, [&] {
+                solver.apply(d, x);
+            }));
+
+            // Référence séquentielle à armes égales : même matrice déjà factorisée
+            std::string sequential = "factorized/n=" + std::to_string(n);
+            if (!selected(sequential, opt)) continue;
+            edp::TridiagonalFactorization factor;
+            factor.factorize(a, b, c);
+            results.push_back(measure(sequential, static_cast<double>(n), opt, [&] {
+                factor.apply(d, x);
+            }));
+        }
+    }
+
+    // Lot de systèmes entrelacés (coefficients propres à chaque système), par niveau
+    // SIMD disponible, contre thomasAlgorithm appelé système par système
+    void benchThomasBatch(const Options& opt, std::vector<Result>& results) {
+        const size_t n = 500;
+        std::vector<size_t> batch_sizes = {16, 64};
+        if (opt.quick) batch_sizes.resize(1);
+
+        const edp::SimdLevel best = edp::detectSimdLevel();
+        std::vector<edp::SimdLevel> levels = {edp::SimdLevel::Scalar};
+        if (best != edp::SimdLevel::Scalar) levels.push_back(edp::SimdLevel::AVX2);
+        if (best == edp::SimdLevel::AVX512) levels.push_back(edp::SimdLevel::AVX512);
+
+        for (size_t nsys : batch_sizes) {
+            const size_t total = n * nsys;
+            std::vector<double> a(total), b(total), c(total), d(total), x;
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = 0; j < nsys; ++j) {
+                    double s = 0.1 + 0.01 * static_cast<double>(j);
+                    size_t idx = i * nsys + j;
+                    a[idx] = (i > 0) ? -s : 0.0;
+                    c[idx] = (i + 1 < n) ? -s : 0.0;
+                    b[idx] = 1.0 + std::fabs(a[idx]) + std::fabs(c[idx]);
+                    d[idx] = std::cos(0.03 * static_cast<double>(i) + static_cast<double>(j));
+                }
+            }
+            edp::ThomasWorkspace ws;
+            const double work = static_cast<double>(total);
+
+            for (edp::SimdLevel level : levels) {
+                const char* simd = (level == edp::SimdLevel::AVX512) ? "avx512"
+                                 : (level == edp::SimdLevel::AVX2)   ? "avx2" : "scalar";
+                std::string name = "thomas_batch/n=" + std::to_string(n) + ",systems="
+                                 + std::to_string(nsys) + ",simd=" + simd;
+                if (!selected(name, opt)) continue;
+                results.push_back(measure(name, work, opt, [&] {
+                    edp::thomasAlgorithmBatch(a, b, c, d, x, nsys, ws, level);
+                }));
+            }
+
+            std::string loop = "thomas_batch/n=" + std::to_string(n) + ",systems="
+                             + std::to_string(nsys) + ",scalar_loop";
+            if (!selected(loop, opt)) continue;
+            std::vector<double> as(n), bs(n), cs(n), ds(n), xs(n);
+            results.push_back(measure(loop, work, opt, [&] {
+                for (size_t j = 0; j < nsys; ++j) {
+                    for (size_t i = 0; i < n; ++i) {
+                        as[i] = a[i * nsys + j];
+                        bs[i] = b[i * nsys + j];
+                        cs[i] = c[i * nsys + j];
+                        ds[i] = d[i * nsys + j];
+                    }
+                    edp::thomasAlgorithm(as, bs, cs, ds, xs, ws);
+                }
+            }));
+        }
+    }
+
+    // Un pas implicite de put américain (problème à obstacle) : Brennan-Schwartz (direct,
+    // O(n)) contre PSOR (itératif, relancé depuis l'obstacle à chaque appel)
+    void benchProjected(const Options& opt, std::vector<Result>& results) {
+        std::vector<size_t> sizes = {100, 500, 2000};
+        if (opt.quick) sizes.resize(2);
+        const double K = 100.0, S_high = 200.0, r = 0.05, sigma = 0.2, dt = 0.01;
+
+        for (size_t n : sizes) {
+            double h = S_high / static_cast<double>(n + 1);
+            std::vector<double> a(n), b(n), c(n), g(n), x;
+            for (size_t i = 0; i < n; ++i) {
+                double S = h * static_cast<double>(i + 1);
+                double diffusion = 0.5 * sigma * sigma * S * S / (h * h);
+                double convection = r * S / (2.0 * h);
+                a[i] = -dt * (diffusion - convection);
+                b[i] = 1.0 + dt * (2.0 * diffusion + r);
+                c[i] = -dt * (diffusion + convection);
+                g[i] = std::max(K - S, 0.0);
+            }
+            a[0] = 0.0;
+            c[n - 1] = 0.0;
+            edp::ThomasWorkspace ws;
+
+            std::string name = "projected/n=" + std::to_string(n) + ",method=brennan_schwartz";
+            if (selected(name, opt)) {
+                results.push_back(measure(name, static_cast<double>(n), opt, [&] {
+                    edp::brennanSchwartz(a, b, c, g, g, x, ws, edp::ExerciseSide::Low);
+                }));
+            }
+            name = "projected/n=" + std::to_string(n) + ",method=psor";
+            if (selected(name, opt)) {
+                double omega = 2.0 / (1.0 + std::sin(3.14159265358979 / static_cast<double>(n)));
+                results.push_back(measure(name, static_cast<double>(n), opt, [&] {
+                    x.clear();
+                    (void)edp::projectedSOR(a, b, c, g, g, x, omega, 1e-12);
+                }));
+            }
+        }
+    }
+
+    // Solve complet d'un call européen (grille, opérateur et factorisation en cache après la chauffe)
+    void benchSolve(const Options& opt, std::vector<Result>& results) {
+        struct Case { size_t N, M; };
+        std::vector<Case> grids = {{100, 50}, {200, 100}, {400, 200}, {800, 400}};
+        if (opt.quick) grids.resize(2);
+        const double thetas[] = {0.5, 1.0};
+
+        edp::PayoffCall call(100.0);
+        double sink = 0.0;
+        for (const Case& g : grids) {
+            for (double theta : thetas) {
+                char name[64];
+                std::snprintf(name, sizeof(name), "solve/N=%zu,M=%zu,theta=%.1f", g.N, g.M, theta);
+                if (!selected(name, opt)) continue;
+
+                edp::PDESolver solver(1.0, 0.05, 0.2, 400.0, theta, g.N, g.M);
+                results.push_back(measure(name, static_cast<double>(g.N * g.M), opt, [&] {
+                    sink += solver.solve(call, 100.0).price;
+                }));
+
+                // Répartition par phase du dernier solve (compilé avec EDP_ENABLE_STATS)
+                if (edp::SolveStats::enabled) {
+                    std::cerr << name << "\n";
+                    solver.getSolveStats().writeCsv(std::cerr);
+                }
+            }
+        }
+        if (!std::isfinite(sink)) std::cerr << "Avertissement : prix non fini" << std::endl;
+    }
+
+    // Construction d'un solveur N = 2000 et préparation de ses matrices,
+    // grille et opérateur pris dans le cache ou reconstruits
+    void benchSetup(const Options& opt, std::vector<Result>& results) {
+        const size_t N = 2000, M = 200;
+        edp::OperatorCache& cache = edp::OperatorCache::instance();
+        for (bool cached : {true, false}) {
+            std::string name = "setup/N=" + std::to_string(N) + ",M=" + std::to_string(M)
+                             + (cached ? ",cache=on" : ",cache=off");
+            if (!selected(name, opt)) continue;
+            cache.setCapacity(cached ? 32 : 0, cached ? 64 : 0); // Capacité nulle : tout est reconstruit
+            results.push_back(measure(name, static_cast<double>(N), opt, [&] {
+                edp::PDESolver solver(1.0, 0.05, 0.2, 500.0, 0.5, N, M);
+                solver.precomputeMatrices();
+            }));
+        }
+        cache.setCapacity(32, 64);
+        cache.clear();
+    }
+
+    // 50 spots : un solve par spot contre un solveSlice et une évaluation groupée
+    void benchLadder(const Options& opt, std::vector<Result>& results) {
+        const size_t N = 250, M = 1000;
+        std::vector<double> spots;
+        for (size_t k = 0; k < 50; ++k) spots.push_back(75.0 + static_cast<double>(k));
+        const double work = static_cast<double>(N * M);
+
+        edp::PayoffCall call(100.0);
+        edp::PDESolver solver(1.0, 0.05, 0.2, 500.0, 0.5, N, M);
+        std::vector<edp::PricingResults> out;
+        double sink = 0.0;
+
+        std::string name = "ladder/spots=50,N=250,M=1000,method=individual";
+        if (selected(name, opt)) {
+            results.push_back(measure(name, work * static_cast<double>(spots.size()), opt, [&] {
+                for (double spot : spots) sink += solver.solve(call, spot).price;
+            }));
+        }
+        name = "ladder/spots=50,N=250,M=1000,method=slice";
+        if (selected(name, opt)) {
+            results.push_back(measure(name, work, opt, [&] {
+                solver.solveSlice(call).evaluate(spots, out, edp::Interpolation::Cubic);
+                sink += out[0].price;
+            }));
+        }
+        if (!std::isfinite(sink)) std::cerr << "Avertissement : prix non fini" << std::endl;
+    }
+
+    // Put américain, grille 800 x 400 avec démarrage de Rannacher
+    void benchAmerican(const Options& opt, std::vector<Result>& results) {
+        const size_t N = 800, M = 400;
+        edp::PayoffPut put(100.0);
+        double sink = 0.0;
+        for (edp::AmericanMethod method : {edp::AmericanMethod::BrennanSchwartz, edp::AmericanMethod::PSOR}) {
+            std::string name = std::string("american/N=800,M=400,method=")
+                             + (method == edp::AmericanMethod::PSOR ? "psor" : "brennan_schwartz");
+            if (!selected(name, opt)) continue;
+            edp::PDESolver solver(1.0, 0.05, 0.2, 400.0, 0.5, N, M);
+            solver.setRannacherSteps(2);
+            solver.setExerciseStyle(edp::ExerciseStyle::American, method);
+            results.push_back(measure(name, static_cast<double>(N * M), opt, [&] {
+                sink += solver.solve(put, 100.0).price;
+            }));
+        }
+        if (!std::isfinite(sink)) std::cerr << "Avertissement : prix non fini" << std::endl;
+    }
+
+    // Sigma constant contre une surface de volatilité locale à 40 tranches (smile mobile)
+    void benchLocalVol(const Options& opt, std::vector<Result>& results) {
+        const size_t N = opt.quick ? 400 : 2000, M = opt.quick ? 100 : 400, slices = 40;
+        const double K = 100.0;
+        std::vector<double> spots = {50.0, 80.0, 100.0, 120.0, 300.0, 400.0};
+        std::vector<double> times(slices), vols;
+        for (size_t k = 0; k < slices; ++k) {
+            times[k] = static_cast<double>(k + 1) / static_cast<double>(slices);
+            for (double s : spots) {
+                double m = std::log(s / K);
+                vols.push_back(0.2 + 0.1 * m * m + 0.002 * static_cast<double>(k));
+            }
+        }
+        edp::LocalVolSurface moving(times, spots, vols);
+        edp::PayoffCall call(K);
+        double sink = 0.0;
+
+        for (bool local : {false, true}) {
+            char name[80];
+            std::snprintf(name, sizeof(name), "local_vol/N=%zu,M=%zu,vol=%s", N, M,
+                          local ? "surface_40_slices" : "constant");
+            if (!selected(name, opt)) continue;
+            edp::PDESolver solver(1.0, 0.05, local ? 0.0 : 0.2, 500.0, 0.5, N, M);
+            solver.setSinhGrid(K, 0.1);
+            if (local) solver.setLocalVolatility(moving);
+            results.push_back(measure(name, static_cast<double>(N * M), opt, [&] {
+                sink += solver.solve(call, 100.0).price;
+            }));
+        }
+        if (!std::isfinite(sink)) std::cerr << "Avertissement : prix non fini" << std::endl;
+    }
+
+    // Mode précision cible (trois niveaux en parallèle puis raffinements) contre la
+    // grille uniforme fine 4000 x 2000 qui tient la même précision
+    void benchTolerance(const Options& opt, std::vector<Result>& results) {
+        edp::PayoffCall call(100.0);
+        edp::ToleranceOptions options;
+        options.S_center = 100.0;
+        double sink = 0.0;
+
+        std::vector<double> tolerances = {1e-3, 1e-4};
+        if (opt.quick) tolerances.resize(1);
+        for (double tolerance : tolerances) {
+            char name[64];
+            std::snprintf(name, sizeof(name), "tolerance/S0=100,tolerance=%.0e", tolerance);
+            if (!selected(name, opt)) continue;
+            edp::ToleranceResult res = edp::solveToTolerance(call, 100.0, 1.0, 0.05, 0.2, 400.0, 0.5, tolerance, options);
+            results.push_back(measure(name, static_cast<double>(res.N * res.M), opt, [&] {
+                sink += edp::solveToTolerance(call, 100.0, 1.0, 0.05, 0.2, 400.0, 0.5, tolerance, options).results.price;
+            }));
+        }
+
+        const std::string brute = "tolerance/S0=100,uniform_N=4000,M=2000";
+        if (!opt.quick && selected(brute, opt)) {
+            edp::PDESolver solver(1.0, 0.05, 0.2, 400.0, 0.5, 4000, 2000);
+            results.push_back(measure(brute, 4000.0 * 2000.0, opt, [&] {
+                sink += solver.solve(call, 100.0).price;
+            }));
+        }
+        if (!std::isfinite(sink)) std::cerr << "Avertissement : prix non fini" << std::endl;
+    }
+
+    // Heston ADI (Craig-Sneyd par défaut), lignes résolues sur 1, 2 et 4 threads
+    void benchHeston(const Options& opt, std::vector<Result>& results) {
+        const size_t Nx = opt.quick ? 100 : 400, Nv = opt.quick ? 50 : 200, M = opt.quick ? 20 : 100;
+        edp::HestonParameters model{1.5, 0.04, 0.3, -0.9};
+        edp::PayoffCall call(100.0);
+        double sink = 0.0;
+        for (unsigned threads : {1u, 2u, 4u}) {
+            char name[80];
+            std::snprintf(name, sizeof(name), "heston/Nx=%zu,Nv=%zu,M=%zu,threads=%u", Nx, Nv, M, threads);
+            if (!selected(name, opt)) continue;
+            edp::HestonADISolver solver(1.0, 0.025, model, 800.0, 1.0, Nx, Nv, M);
+            solver.setThreads(threads);
+            results.push_back(measure(name, static_cast<double>(Nx * Nv * M), opt, [&] {
+                sink += solver.solve(call, 100.0, 0.04).price;
+            }));
+        }
+        if (!std::isfinite(sink)) std::cerr << "Avertissement : prix non fini" << std::endl;
+    }
+
+    // Solve par lot de 64 calls (strikes 60 à 140), en double, en float et en mixte ;
+    // error : écart de prix maximal au lot en double sur la même grille
+    void benchBatch(const Options& opt, std::vector<Result>& results) {
+        struct Case { size_t N, M; };
+        std::vector<Case> grids = {{200, 100}, {1000, 500}};
+        if (opt.quick) grids.resize(1);
+        const size_t K = 64;
+
+        std::vector<edp::PayoffCall> calls;
+        std::vector<const edp::Payoff*> payoffs;
+        calls.reserve(K);
+        for (size_t k = 0; k < K; ++k) {
+            calls.emplace_back(60.0 + 80.0 * static_cast<double>(k) / static_cast<double>(K - 1));
+        }
+        for (const auto& c : calls) payoffs.push_back(&c);
+        const std::vector<double> spots(K, 100.0);
+
+        double sink = 0.0;
+        for (const Case& g : grids) {
+            edp::PDESolver reference(1.0, 0.05, 0.2, 500.0, 0.5, g.N, g.M);
+            const std::vector<edp::PricingResults> exact = reference.solve(payoffs, spots);
+            for (edp::Precision p : {edp::Precision::Double, edp::Precision::Float, edp::Precision::Mixed}) {
+                const char* precision = (p == edp::Precision::Double) ? "double"
+                                      : (p == edp::Precision::Float) ? "float" : "mixed";
+                char name[80];
+                std::snprintf(name, sizeof(name), "batch/N=%zu,M=%zu,contracts=%zu,precision=%s",
+                              g.N, g.M, K, precision);
+                if (!selected(name, opt)) continue;
+
+                edp::PDESolver solver(1.0, 0.05, 0.2, 500.0, 0.5, g.N, g.M);
+                solver.setPrecision(p);
+                std::vector<edp::PricingResults> res = solver.solve(payoffs, spots);
+                double error = 0.0;
+                for (size_t k = 0; k < K; ++k) {
+                    error = std::max(error, std::fabs(res[k].price - exact[k].price));
+                }
+                results.push_back(measure(name, static_cast<double>(g.N * g.M * K), opt, [&] {
+                    sink += solver.solve(payoffs, spots)[0].price;
+                }));
+                results.back().error = error;
+            }
+        }
+        if (!std::isfinite(sink)) std::cerr << "Avertissement : prix non fini" << std::endl;
+    }
+
+    // Portefeuille de 200 contrats (deux grilles d'affinité), calls et puts alternés
+    std::vector<edp::Contract> benchPortfolio(size_t count) {
+        std::vector<edp::Contract> contracts(count);
+        for (size_t k = 0; k < count; ++k) {
+            edp::Contract& c = contracts[k];
+            c.is_call = (k % 2 == 0);
+            c.S0 = 80.0 + 40.0 * static_cast<double>(k) / static_cast<double>(count);
+            c.K = 100.0;
+            c.T = 0.5 + 0.005 * static_cast<double>(k % 100);
+            c.r = 0.03;
+            c.sigma = 0.15 + 0.05 * static_cast<double>(k % 4);
+            c.S_max = (k % 3 == 0) ? 400.0 : 500.0;
+            c.N = 200;
+            c.M = 100;
+        }
+        return contracts;
+    }
+
+    // Pricing batch d'un fichier en mémoire, CSV puis binaire (lecture, solves, écriture)
+    void benchBatchPricer(const Options& opt, std::vector<Result>& results) {
+        const size_t count = opt.quick ? 50 : 200;
+        const std::vector<edp::Contract> contracts = benchPortfolio(count);
+        std::ostringstream csv, bin;
+        csv << "type,S0,K,T,r,sigma,S_max,N,M,theta\n";
+        edp::writeBinaryHeader(bin);
+        for (const edp::Contract& c : contracts) {
+            csv << (c.is_call ? "call" : "put") << "," << c.S0 << "," << c.K << "," << c.T << ","
+                << c.r << "," << c.sigma << "," << c.S_max << "," << c.N << "," << c.M << "," << c.theta << "\n";
+            edp::writeBinaryContract(bin, c);
+        }
+        const std::string csv_data = csv.str(), bin_data = bin.str();
+        edp::BatchOptions options;
+        options.chunk_size = 64;
+
+        for (bool binary : {false, true}) {
+            std::string name = "batch_pricer/contracts=" + std::to_string(count) + (binary ? ",format=binary" : ",format=csv");
+            if (!selected(name, opt)) continue;
+            const std::string& data = binary ? bin_data : csv_data;
+            results.push_back(measure(name, static_cast<double>(count * 200 * 100), opt, [&] {
+                edp::ContractReader reader(data.data(), data.size());
+                std::ostringstream out;
+                (void)edp::priceBatch(reader, out, options);
+            }));
+        }
+    }
+
+    // PricingEngine::priceAll sur 1, 2, 4... workers (jusqu'au nombre de cœurs, au moins 2)
+    void benchEngine(const Options& opt, std::vector<Result>& results) {
+        const std::vector<edp::Contract> contracts = benchPortfolio(opt.quick ? 60 : 240);
+        const unsigned max_threads = std::max(2u, std::thread::hardware_concurrency());
+        std::vector<edp::PricingResults> out(contracts.size());
+        for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+            std::string name = "engine/contracts=" + std::to_string(contracts.size())
+                             + ",threads=" + std::to_string(threads);
+            if (!selected(name, opt)) continue;
+            edp::PricingEngine engine(threads);
+            results.push_back(measure(name, static_cast<double>(contracts.size() * 200 * 100), opt, [&] {
+                engine.priceAll(contracts.data(), contracts.size(), out.data());
+            }));
+        }
+    }
+
+    // Grille de 7 chocs de spot x 4 chocs de vol sur 48 contrats : ScenarioEngine
+    // (un solve par lot, grille et vol) contre un solve par contrat et par choc de vol
+    void benchScenario(const Options& opt, std::vector<Result>& results) {
+        std::vector<edp::Contract> portfolio(48);
+        for (size_t k = 0; k < portfolio.size(); ++k) {
+            edp::Contract& c = portfolio[k];
+            c.is_call = (k % 2 == 0);
+            c.K = 80.0 + 5.0 * static_cast<double>(k % 8);
+            c.S0 = 100.0;
+            c.T = (k % 3 == 0) ? 0.5 : 1.0;
+            c.r = 0.03;
+            c.sigma = 0.2;
+            c.S_max = (k < 24) ? 400.0 : 500.0;
+        }
+        edp::ScenarioGrid grid;
+        grid.spot_shocks = {-0.2, -0.1, -0.05, 0.0, 0.05, 0.1, 0.2};
+        grid.vol_shocks = {-0.05, 0.0, 0.05, 0.1};
+        const double work = static_cast<double>(portfolio.size() * grid.vol_shocks.size() * 200 * 100);
+
+        std::string name = "scenario/contracts=48,scenarios=28,method=engine";
+        if (selected(name, opt)) {
+            edp::ScenarioEngine engine;
+            edp::ScenarioResults out;
+            results.push_back(measure(name, work, opt, [&] { engine.run(portfolio, grid, out); }));
+        }
+
+        name = "scenario/contracts=48,scenarios=28,method=per_contract";
+        if (opt.quick || !selected(name, opt)) return;
+        double sink = 0.0;
+        std::vector<edp::PricingResults> out;
+        results.push_back(measure(name, work, opt, [&] {
+            for (const edp::Contract& c : portfolio) {
+                for (double shock : grid.vol_shocks) {
+                    edp::PDESolver solver(c.T, c.r, c.sigma + shock, c.S_max, c.theta, c.N, c.M);
+                    edp::SolutionSlice slice = c.is_call ? solver.solveSlice(edp::PayoffCall(c.K))
+                                                         : solver.solveSlice(edp::PayoffPut(c.K));
+                    sink += slice.evaluate(c.S0).price;
+                }
+            }
+        }));
+        if (!std::isfinite(sink)) std::cerr << "Avertissement : prix non fini" << std::endl;
+    }
+
+    // Formule fermée sur les faces d'une grille en ln S (source de la variable de contrôle),
+    // ln S fourni ou recalculé
+    void benchBlackScholes(const Options& opt, std::vector<Result>& results) {
+        std::vector<size_t> sizes = {200, 2000, 20000};
+        if (opt.quick) sizes.resize(2);
+
+        for (size_t n : sizes) {
+            std::vector<double> x(n), S(n), price(n), delta(n);
+            for (size_t i = 0; i < n; ++i) {
+                x[i] = std::log(500.0 / 3000.0) + std::log(3000.0) * static_cast<double>(i) / static_cast<double>(n - 1);
+                S[i] = std::exp(x[i]);
+            }
+            for (bool with_log : {true, false}) {
+                std::string name = "black_scholes/n=" + std::to_string(n) + (with_log ? ",log_S" : "");
+                if (!selected(name, opt)) continue;
+                results.push_back(measure(name, static_cast<double>(n), opt, [&] {
+                    edp::blackScholesAtSpots(false, S.data(), with_log ? x.data() : nullptr, n,
+                                             100.0, 0.5, 0.05, 0.2, price.data(), delta.data());
+                }));
+            }
+        }
+    }
+
+    // Volatilité implicite PDE d'une nappe de cotations (temps par appel = toute la nappe)
+    void benchImpliedVol(const Options& opt, std::vector<Result>& results) {
+        const size_t n_quotes = opt.quick ? 64 : 256;
+        std::string name = "implied_vol/quotes=" + std::to_string(n_quotes);
+        if (!selected(name, opt)) return;
+
+        std::vector<edp::Contract> quotes(n_quotes);
+        std::vector<double> prices(n_quotes);
+        for (size_t k = 0; k < n_quotes; ++k) {
+            edp::Contract& c = quotes[k];
+            c.is_call = (k % 2 == 0);
+            c.S0 = 100.0;
+            c.K = 80.0 + 40.0 * static_cast<double>(k / 2 % 32) / 31.0;
+            c.T = 0.5 + 0.5 * static_cast<double>(k / 64);
+            c.r = 0.03;
+            c.S_max = 400.0;
+            double sigma = 0.18 + 0.002 * std::fabs(c.K - 100.0);
+            edp::PDESolver solver(c.T, c.r, sigma, c.S_max, c.theta, c.N, c.M);
+            prices[k] = c.is_call ? solver.solve(edp::PayoffCall(c.K), c.S0).price
+                                  : solver.solve(edp::PayoffPut(c.K), c.S0).price;
+        }
+
+        // Travail : noeuds x pas de tous les solves effectués
+        edp::ImpliedVolSolver solver;
+        std::vector<edp::ImpliedVolResult> out;
+        solver.solve(quotes, prices, out);
+        double work = static_cast<double>(solver.getSolveCount() * quotes[0].N * quotes[0].M);
+        results.push_back(measure(name, work, opt, [&] { solver.solve(quotes, prices, out); }));
+    }
+
+    // --- JSON ---
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results, const Options& opt) {
+        out << "{\n  \"suite\": \"EDP_Bench\",\n  \"quick\": " << (opt.quick ? "true" : "false")
+            << ",\n  \"benchmarks\": [\n";
+        char buffer[512];
+        for (size_t k = 0; k < results.size(); ++k) {
+            const Result& r = results[k];
+            std::snprintf(buffer, sizeof(buffer),
+                          "    {\"name\": \"%s\", \"samples\": %zu, \"iterations\": %zu, "
+                          "\"median_ns\": %.1f, \"p99_ns\": %.1f, \"min_ns\": %.1f, "
+                          "\"ns_per_node_step\": %.4f",
+                          r.name.c_str(), r.samples, r.iterations, r.median_ns, r.p99_ns, r.min_ns,
+                          r.ns_per_node_step);
+            out << buffer;
+            if (r.error >= 0.0) {
+                std::snprintf(buffer, sizeof(buffer), ", \"error\": %.3e", r.error);
+                out << buffer;
+            }
+            out << "}" << ((k + 1 < results.size()) ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    // Lecture d'une référence produite par writeJson : couples (name, median_ns).
+    // Lecteur minimal, suffisant pour le format ci-dessus.
+    std::vector<Result> readBaseline(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Erreur Bench: Impossible d'ouvrir la reference " + path);
+        }
+        std::stringstream ss;
+        ss << file.rdbuf();
+        const std::string text = ss.str();
+
+        std::vector<Result> baseline;
+        const std::string name_key = "\"name\": \"", median_key = "\"median_ns\": ";
+        size_t pos = 0;
+        while ((pos = text.find(name_key, pos)) != std::string::npos) {
+            pos += name_key.size();
+            size_t end = text.find('"', pos);
+            size_t median = text.find(median_key, end);
+            if (end == std::string::npos || median == std::string::npos) {
+                throw std::runtime_error("Erreur Bench: Reference mal formee " + path);
+            }
+            Result r;
+            r.name = text.substr(pos, end - pos);
+            r.median_ns = std::strtod(text.c_str() + median + median_key.size(), nullptr);
+            baseline.push_back(r);
+            pos = end;
+        }
+        return baseline;
+    }
+
+    // Nombre de régressions (médiane > référence * (1 + tolérance))
+    size_t compare(const std::vector<Result>& results, const std::vector<Result>& baseline, double tolerance) {
+        size_t regressions = 0;
+        std::cerr << "\nbenchmark,baseline_ns,median_ns,ratio,status\n";
+        for (const Result& r : results) {
+            auto it = std::find_if(baseline.begin(), baseline.end(),
+                                   [&](const Result& b) { return b.name == r.name; });
+            if (it == baseline.end()) {
+                std::cerr << r.name << ",," << r.median_ns << ",,nouveau\n";
+                continue;
+            }
+            double ratio = r.median_ns / it->median_ns;
+            bool regressed = ratio > 1.0 + tolerance;
+            regressions += regressed ? 1 : 0;
+            std::cerr << r.name << "," << it->median_ns << "," << r.median_ns << "," << ratio << ","
+                      << (regressed ? "REGRESSION" : "ok") << "\n";
+        }
+        return regressions;
+    }
+
+    bool parseArguments(int argc, char* argv[], Options& opt) {
+        for (int k = 1; k < argc; ++k) {
+            std::string arg = argv[k];
+            bool has_value = (k + 1 < argc);
+            if (arg == "--quick") {
+                opt.quick = true;
+                opt.samples = std::min<size_t>(opt.samples, 7);
+            } else if (arg == "--filter" && has_value) {
+                opt.filter = argv[++k];
+            } else if (arg == "--samples" && has_value) {
+                opt.samples = std::max<long>(1, std::strtol(argv[++k], nullptr, 10));
+            } else if (arg == "--output" && has_value) {
+                opt.output = argv[++k];
+            } else if (arg == "--baseline" && has_value) {
+                opt.baseline = argv[++k];
+            } else if (arg == "--tolerance" && has_value) {
+                opt.tolerance = std::strtod(argv[++k], nullptr);
+            } else {
+                std::cerr << "Usage : EDP_Bench [--quick] [--filter motif] [--samples n] [--output run.json]\n"
+                             "                  [--baseline reference.json] [--tolerance 0.10]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parseArguments(argc, argv, opt)) return 1;
+
+    try {
+        std::vector<Result> results;
+        benchThomas(opt, results);
+        benchPartitioned(opt, results);
+        benchThomasBatch(opt, results);
+        benchProjected(opt, results);
+        benchSolve(opt, results);
+        benchSetup(opt, results);
+        benchBatch(opt, results);
+        benchLadder(opt, results);
+        benchAmerican(opt, results);
+        benchLocalVol(opt, results);
+        benchTolerance(opt, results);
+        benchHeston(opt, results);
+        benchBatchPricer(opt, results);
+        benchEngine(opt, results);
+        benchScenario(opt, results);
+        benchBlackScholes(opt, results);
+        benchImpliedVol(opt, results);
+
+        // Résumé lisible sur stderr, JSON sur stdout ou dans le fichier demandé
+        std::cerr << "benchmark,median_ns,p99_ns,ns_per_node_step,error\n";
+        for (const Result& r : results) {
+            std::cerr << r.name << "," << r.median_ns << "," << r.p99_ns << "," << r.ns_per_node_step << ",";
+            if (r.error >= 0.0) std::cerr << r.error;
+            std::cerr << "\n";
+        }
+        if (opt.output.empty()) {
+            writeJson(std::cout, results, opt);
+        } else {
+            std::ofstream out(opt.output);
+            if (!out) {
+                std::cerr << "ERREUR : impossible d'ecrire " << opt.output << std::endl;
+                return 1;
+            }
+            writeJson(out, results, opt);
+        }
+
+        if (!opt.baseline.empty()) {
+            size_t regressions = compare(results, readBaseline(opt.baseline), opt.tolerance);
+            if (regressions > 0) {
+                std::cerr << "Echec : " << regressions << " regression(s) au-dela de "
+                          << 100.0 * opt.tolerance << " %" << std::endl;
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ERREUR FATALE : " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+#ifndef EDP_BATCHPRICER_H
+#define EDP_BATCHPRICER_H
+
+#include "edp/PricingEngine.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace edp {
+
+    /*
+     * CLASSE MAPPEDFILE
+     * Fichier projeté en mémoire en lecture seule (mmap, lecture séquentielle annoncée).
+     * Les pages sont chargées à la demande et libérables par le système :
+     * un fichier plus gros que la RAM se lit sans copie.
+     */
+    class MappedFile {
+    private:
+        const char* begin_ = nullptr;
+        size_t size_ = 0;
+        std::vector<char> fallback; // Systèmes sans mmap : lecture complète
+
+    public:
+        // @throw std::runtime_error Si le fichier ne peut être ouvert ou projeté.
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] const char* data() const { return begin_; }
+        [[nodiscard]] size_t size() const { return size_; }
+    };
+
+    /*
+     * CLASSE CONTRACTREADER
+     * Lecture des contrats directement dans la projection, sans copie ni allocation par ligne.
+     *
+     * CSV (en-tête optionnel, lignes vides et '#' ignorées) :
+     *   type,S0,K,T,r,sigma[,S_max[,N[,M[,theta[,tolerance]]]]]     type : call/put (ou C/P, 1/0)
+     * tolerance > 0 : grille automatique (voir gridFor), S_max, N et M ignorés.
+     * Binaire : en-tête "EDPBIN1\0" puis des enregistrements de kBinaryRecordSize octets
+     * (petit-boutiste) : uint32 type, uint32 N, uint32 M, uint32 réservé,
+     * puis S0, K, T, r, sigma, S_max, theta en double (voir writeBinaryContract).
+     */
+    class ContractReader {
+    private:
+        const char* cursor;
+        const char* end;
+        bool binary = false;
+        size_t line = 0; // Ligne (CSV) ou enregistrement (binaire) courant
+
+        bool nextCsv(Contract& c);
+        bool nextBinary(Contract& c);
+
+    public:
+        static constexpr size_t kBinaryRecordSize = 72;
+
+        // Le format est détecté sur l'en-tête binaire
+        explicit ContractReader(const MappedFile& file);
+        ContractReader(const char* data, size_t size);
+
+        // Contrat suivant ; false en fin de fichier.
+        // @throw std::runtime_error Si une ligne ou un enregistrement est invalide ; elle est
+        // consommée, l'appel suivant reprend à la ligne d'après.
+        bool next(Contract& c);
+
+        [[nodiscard]] bool isBinary() const { return binary; }
+    };
+
+    // Écrit l'en-tête binaire, puis un enregistrement par contrat
+    void writeBinaryHeader(std::ostream& out);
+    void writeBinaryContract(std::ostream& out, const Contract& c);
+
+    struct BatchOptions {
+        unsigned threads = 0;     // 0 : nombre de cœurs
+        size_t chunk_size = 4096; // Contrats en mémoire à la fois (mémoire bornée)
+        bool sensitivities = false; // Vega et Rho (équations tangentes) ; 0 sinon
+    };
+
+    struct BatchStats {
+        size_t contracts = 0;
+        size_t failed = 0;    // Contrats en erreur (paramètres invalides...)
+        size_t unachieved = 0; // Contrats pricés sans atteindre leur tolérance (grille plafonnée)
+        double seconds = 0.0;
+        SolveStats solver;    // Cumul des solveurs du lot (renseigné si EDP_ENABLE_STATS)
+        [[nodiscard]] double contractsPerSecond() const {
+            return seconds > 0.0 ? static_cast<double>(contracts) / seconds : 0.0;
+        }
+    };
+
+    /**
+     * @brief Price tout le portefeuille par paquets de chunk_size contrats.
+     * * Chaque paquet est pricé en parallèle par un PricingEngine (un PDESolver par worker,
+     * grilles et opérateurs partagés via le cache), puis écrit dans l'ordre du fichier avant la lecture du suivant :
+     * la mémoire reste bornée quelle que soit la taille du fichier.
+     * Sortie CSV : index,price,delta,gamma,theta,vega,rho,status ; une ligne mal formée
+     * ou un contrat invalide donne le statut "erreur: ..." (entre guillemets, compté dans
+     * failed) sans interrompre le lot, un contrat dont la tolérance n'est pas atteinte
+     * (grille plafonnée) le statut "tolerance_non_atteinte".
+     */
+    BatchStats priceBatch(ContractReader& reader, std::ostream& out,
+                          const BatchOptions& options = BatchOptions());
+
+} // namespace edp
+
+#endif // EDP_BATCHPRICER_H
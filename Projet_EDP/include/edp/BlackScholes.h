@@ -0,0 +1,45 @@
+#ifndef EDP_BLACKSCHOLES_H
+#define EDP_BLACKSCHOLES_H
+
+#include "edp/SolutionSlice.h"
+#include <cstddef>
+
+namespace edp {
+
+    /*
+     * FORMULES FERMÉES DE BLACK-SCHOLES (européennes, sans dividende)
+     * Référence analytique du solveur PDE et point de départ des inversions.
+     */
+
+    [[nodiscard]] double normalCdf(double x);
+    [[nodiscard]] double normalPdf(double x);
+
+    [[nodiscard]] double blackScholesPrice(bool is_call, double S0, double K, double T, double r, double sigma);
+
+    // Prix et Grecques en un point (Theta en temps calendaire)
+    [[nodiscard]] PricingResults blackScholesGreeks(bool is_call, double S0, double K, double T,
+                                                    double r, double sigma);
+
+    /**
+     * @brief Prix (et Delta) de Black-Scholes en n spots de même strike, maturité, r et sigma.
+     * * Les invariants (actualisation, sigma sqrt(T), ln K...) sont calculés une fois ;
+     * chaque point coûte deux erfc de la libm (boucle scalaire, non vectorisée).
+     * Call et put par la formule directe : un put loin hors de la monnaie garde sa
+     * précision relative. log_S (facultatif) : ln S déjà connu (noeuds d'une grille
+     * en ln S), évite un logarithme par point. delta peut être nul.
+     */
+    void blackScholesAtSpots(bool is_call, const double* S, const double* log_S, size_t n,
+                             double K, double T, double r, double sigma,
+                             double* price, double* delta);
+
+    // dPrix/dsigma (identique pour le call et le put)
+    [[nodiscard]] double blackScholesVega(double S0, double K, double T, double r, double sigma);
+
+    // Volatilité implicite (Newton depuis le point d'inflexion de Manaster-Koehler,
+    // protégé par bissection). NaN si le prix sort des bornes de non-arbitrage.
+    [[nodiscard]] double blackScholesImpliedVol(bool is_call, double price, double S0, double K,
+                                                double T, double r);
+
+} // namespace edp
+
+#endif // EDP_BLACKSCHOLES_H
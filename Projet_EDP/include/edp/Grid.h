@@ -0,0 +1,62 @@
+#ifndef EDP_GRID_H
+#define EDP_GRID_H
+
+#include <vector>
+#include <cstddef>
+
+namespace edp {
+
+    enum class GridType {
+        Uniform, // Pas constant en ln(S)
+        Sinh,    // Noeuds concentrés autour d'un centre (strike, spot) par un étirement sinh
+        Custom   // Noeuds fournis par l'utilisateur
+    };
+
+    /*
+     * CLASSE LOGGRID
+     * Grille spatiale en x = ln(S), croissante, au moins 6 noeuds.
+     * locate() renvoie l'intervalle d'un point en O(1) pour les grilles uniforme
+     * et sinh (inversion analytique), en O(log N) pour une grille utilisateur.
+     */
+    class LogGrid {
+    private:
+        GridType type = GridType::Uniform;
+        std::vector<double> x;
+
+        // Uniforme : x_i = x_min + i * step
+        // Sinh     : x_i = center + alpha * sinh(c1 + i * step), step en variable étirée
+        double x_min = 0.0;
+        double step = 0.0;
+        double center = 0.0;
+        double alpha = 0.0;
+        double c1 = 0.0;
+
+    public:
+        LogGrid() = default;
+
+        [[nodiscard]] static LogGrid uniform(double x_min, double x_max, size_t N);
+
+        // alpha : largeur (en ln(S)) de la zone de concentration ; plus alpha est petit,
+        // plus les noeuds se resserrent autour de x_center
+        [[nodiscard]] static LogGrid sinh(double x_min, double x_max, size_t N,
+                                          double x_center, double alpha);
+
+        // Noeuds en ln(S), strictement croissants
+        [[nodiscard]] static LogGrid custom(const std::vector<double>& nodes);
+
+        [[nodiscard]] GridType getType() const { return type; }
+        [[nodiscard]] bool isUniform() const { return type == GridType::Uniform; }
+        [[nodiscard]] size_t size() const { return x.size(); }
+        [[nodiscard]] const std::vector<double>& nodes() const { return x; }
+        [[nodiscard]] double operator[](size_t i) const { return x[i]; }
+
+        // Pas constant (grille uniforme uniquement)
+        [[nodiscard]] double uniformStep() const { return step; }
+
+        // Indice i tel que x[i] <= target_x < x[i+1], borné à [lo, hi]
+        [[nodiscard]] size_t locate(double target_x, size_t lo, size_t hi) const;
+    };
+
+} // namespace edp
+
+#endif // EDP_GRID_H
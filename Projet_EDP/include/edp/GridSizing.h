@@ -0,0 +1,56 @@
+#ifndef EDP_GRIDSIZING_H
+#define EDP_GRIDSIZING_H
+
+#include <cstddef>
+
+namespace edp {
+
+    // Grille choisie : domaine [S_min, S_max] (uniforme en ln S), N noeuds, M pas de temps,
+    // et pas de Rannacher à activer (setRannacherSteps) pour tenir la précision annoncée
+    struct GridChoice {
+        double S_min = 0.0;
+        double S_max = 0.0;
+        size_t N = 0;
+        size_t M = 0;
+        size_t rannacher_steps = 0;
+        double estimated_error = 0.0; // Erreur du modèle pour N et M retenus (chooseGrid ; 0 sinon)
+        bool achievable = true;       // false : N ou M plafonné, estimated_error > tolérance
+
+        [[nodiscard]] size_t nodeSteps() const { return N * M; }
+    };
+
+    // Paramètres du dimensionnement automatique
+    struct GridSizingOptions {
+        double n_std = 5.0;     // Demi-largeur du domaine, en écarts-types sigma sqrt(T) de ln S
+        size_t N_min = 25, N_max = 20001;
+        size_t M_min = 10, M_max = 10000;
+    };
+
+    /**
+     * @brief Domaine en ln S : n_std écarts-types sigma sqrt(T) autour du forward,
+     * élargi pour contenir le spot et le strike.
+     * * Bornes : [min(ln F, ln S0, ln K) - w, max(ln F, ln S0, ln K) + w], w = n_std sigma sqrt(T).
+     * La borne basse est décalée (d'au plus un pas) pour que le strike tombe sur un noeud :
+     * le coin du payoff ne bouge plus d'une cellule à l'autre quand N change
+     * (2 pas de Rannacher demandés pour amortir CN sur ce noeud). M reste à fixer.
+     * @throw std::invalid_argument Si S0, K, T, sigma ou n_std ne sont pas positifs, ou N < 6.
+     */
+    [[nodiscard]] GridChoice chooseDomain(double S0, double K, double T, double r, double sigma,
+                                          size_t N, double n_std = 5.0);
+
+    /**
+     * @brief Domaine automatique, N et M pour une erreur absolue visée sur le prix (CN).
+     * * Modèle d'erreur, étalonné sur Black-Scholes, à l'échelle du prix ATM K sigma sqrt(T) :
+     * espace c_x K sigma sqrt(T) (dx / sigma sqrt(T))^2, temps c_t K sigma sqrt(T) / M^2 ;
+     * la tolérance est partagée entre les deux. N et M sont bornés par options : si
+     * N_max ou M_max plafonne la grille, achievable = false et estimated_error donne
+     * l'erreur attendue de la grille plafonnée (au-dessus de la tolérance).
+     * @throw std::invalid_argument Paramètres non positifs ou tolérance non positive.
+     */
+    [[nodiscard]] GridChoice chooseGrid(double S0, double K, double T, double r, double sigma,
+                                        double tolerance,
+                                        const GridSizingOptions& options = GridSizingOptions());
+
+} // namespace edp
+
+#endif // EDP_GRIDSIZING_H
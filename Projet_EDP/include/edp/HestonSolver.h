@@ -0,0 +1,129 @@
+#ifndef EDP_HESTONSOLVER_H
+#define EDP_HESTONSOLVER_H
+
+#include "edp/Payoff.h"
+#include "edp/LinearSolver.h"
+#include "edp/SolutionSlice.h"
+#include "edp/ThreadPool.h"
+#include <vector>
+#include <cstddef>
+#include <memory>
+
+namespace edp {
+
+    // Dynamique de la variance : dv = kappa (theta - v) dt + xi sqrt(v) dW_v, d<W_S, W_v> = rho dt
+    struct HestonParameters {
+        double kappa; // Vitesse de retour à la moyenne
+        double theta; // Variance de long terme
+        double xi;    // Volatilité de la variance
+        double rho;   // Corrélation spot / variance
+    };
+
+    // Découpage ADI du pas de temps
+    enum class AdiScheme {
+        Douglas,   // Prédicteur explicite puis une correction implicite par direction
+        CraigSneyd // Douglas + correction du terme croisé et seconde passe implicite
+    };
+
+    /*
+     * CLASSE HESTONADISOLVER
+     * Modèle de Heston en (x = ln(S), v), grilles uniformes, schéma ADI (Douglas ou
+     * Craig-Sneyd). L'opérateur est découpé en A0 (terme croisé, explicite),
+     * A1 (direction x) et A2 (direction v), chaque demi-pas implicite se ramenant
+     * à des systèmes tridiagonaux indépendants le long des lignes de la grille.
+     *
+     * Stockage ligne par ligne (U[j * Nx + i], j : variance, i : spot) :
+     * - lignes en x : contiguës, une factorisation par variance v_j ;
+     * - lignes en v : la matrice ne dépend pas de i, le stockage est déjà la disposition
+     *   entrelacée de TridiagonalFactorization::applyInterleaved ; la grille est traitée
+     *   par blocs de colonnes copiés dans un tampon (pas unitaire sur les colonnes).
+     * Lignes et blocs sont répartis sur un ThreadPool ; le résultat ne dépend pas
+     * du nombre de threads.
+     *
+     * Bornes : Dirichlet en S (même approximation que PDESolver), dégénérescence
+     * v = 0 (dérive kappa*theta décentrée), Neumann dV/dv = 0 en v_max.
+     */
+    class HestonADISolver {
+    private:
+        double T, r;
+        HestonParameters model;
+        double S_max, v_max;
+        size_t Nx, Nv, M;
+        double dx, dv;
+
+        AdiScheme scheme = AdiScheme::CraigSneyd;
+        double theta_adi = 0.5;
+        size_t damping_steps = 2;   // Premiers pas remplacés par deux demi-pas de Douglas implicite
+        unsigned n_threads = 0;     // 0 : nombre de cœurs
+        std::unique_ptr<ThreadPool> pool;
+
+        std::vector<double> x, S, v;
+
+        // Coefficients (par unité de temps) des opérateurs, par variance v_j
+        std::vector<double> a1_lower, a1_diag, a1_upper; // A1 (identiques sur une ligne x)
+        std::vector<double> a2_lower, a2_diag, a2_upper; // A2 (identiques pour toutes les colonnes)
+        std::vector<double> a0_coef;                     // A0 : rho xi v_j / (4 dx dv)
+
+        // Factorisations des matrices I - theta * step * A1 (une par ligne) et I - theta * step * A2
+        struct LineFactors {
+            double step = -1.0;
+            double theta = -1.0;
+            std::vector<TridiagonalFactorization> x_lines;
+            TridiagonalFactorization v_lines;
+        };
+        LineFactors factors[2]; // Pas amorti et pas courant
+        size_t last_factors = 1;
+        size_t factorizations = 0;
+
+        // Espaces de travail (alloués une fois)
+        std::vector<double> U, U_prev, Y;
+        std::vector<double> A0U, A1U, A2U, A0Y;
+        std::vector<double> payoff_row;
+        std::vector<std::vector<double>> line_buffers;  // Un tampon par tranche de lignes x
+        std::vector<std::vector<double>> block_buffers; // Un tampon par bloc de colonnes
+
+        void buildCoefficients();
+        const LineFactors& lineFactors(double step, double theta);
+        ThreadPool& threads();
+
+        void applyOperators(const std::vector<double>& W, std::vector<double>* out0,
+                            std::vector<double>* out1, std::vector<double>* out2);
+        void solveXLines(const LineFactors& f, double step, double theta, double V_low, double V_high);
+        void solveVLines(const LineFactors& f, double step, double theta, double V_low, double V_high);
+        void adiStep(double step, double theta, AdiScheme kind, double V_low, double V_high);
+
+    public:
+        /**
+         * @param Nx Noeuds en ln(S) sur [ln(S_max / 3000), ln(S_max)]
+         * @param Nv Noeuds en variance sur [0, v_max]
+         * @param M  Pas de temps
+         * @throw std::invalid_argument Si les paramètres sont invalides.
+         */
+        HestonADISolver(double T, double r, const HestonParameters& model,
+                        double S_max, double v_max, size_t Nx, size_t Nv, size_t M);
+        ~HestonADISolver();
+
+        // theta = 0.5 : Crank-Nicolson dans chaque direction
+        void setScheme(AdiScheme scheme, double theta = 0.5);
+        // Nombre de pas amortis au démarrage (payoff non régulier)
+        void setDampingSteps(size_t steps);
+        // Threads des résolutions de lignes (0 = nombre de cœurs, 1 = séquentiel)
+        void setThreads(unsigned nThreads);
+
+        /**
+         * @brief Résout jusqu'à t = 0 et interpole en (S0, v0) (Lagrange cubique en x et en v).
+         * Vega = dV/d(sqrt(v0)), Theta = dV/dt ; Rho non calculé : NaN (et non 0, qui
+         * passerait pour une sensibilité nulle).
+         */
+        [[nodiscard]] PricingResults solve(const Payoff& payoff, double S0, double v0);
+
+        // Solution à t = 0, U[j * Nx + i] = V(S_i, v_j)
+        [[nodiscard]] const std::vector<double>& values() const { return U; }
+        [[nodiscard]] const std::vector<double>& spotNodes() const { return S; }
+        [[nodiscard]] const std::vector<double>& varianceNodes() const { return v; }
+        [[nodiscard]] size_t getFactorizationCount() const { return factorizations; }
+    };
+
+} // namespace edp
+
+#endif // EDP_HESTONSOLVER_H
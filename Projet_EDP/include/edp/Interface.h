@@ -2,6 +2,7 @@
 #define EDP_INTERFACE_H
 
 #include <cstddef> 
+#include <string>
 
 namespace edp {
 
@@ -9,6 +10,7 @@ enum class RunMode {
     Pricer,
     TestPDE,
     TestSolver,
+    Batch,     // Portefeuille lu dans un fichier, sans saisie (ligne de commande)
     Unknown
 };
 
@@ -24,16 +26,31 @@ private:
     double sigma = 0.0;   
 
     // Paramètres Grille / Solver
-    double S_max = 0.0;   
+    double S_max = 0.0;     // 0 : domaine automatique (GridSizing)
     double theta_scheme = 0.5; 
     size_t M = 100;       
     size_t N = 100;      
+    double tolerance = 0.0; // Précision cible sur le prix (0 = M et N saisis) ; Richardson,
+                            // ou modèle d'erreur de GridSizing si le domaine est automatique
 
     bool isCall = true;    
 
+    // Mode batch : PricerApp --batch <entree.csv|.bin> [--output <sortie.csv>] [--threads <n>]
+    //                       [--stats <stats.csv>] [--sensitivities]
+    std::string batchInput;
+    std::string batchOutput;   // Vide : sortie standard
+    unsigned batchThreads = 0; // 0 : nombre de cœurs
+    std::string batchStats;    // Vide : pas d'export des statistiques de solve
+    bool batchSensitivities = false; // Vega et Rho dans la sortie (0 sinon)
+
 public:
     Interface() = default; 
     
+    // Analyse des arguments ; renvoie true si le mode batch est demandé
+    // (aucune saisie sur std::cin ensuite).
+    // @throw std::invalid_argument Si les arguments sont incomplets ou inconnus.
+    bool parseCommandLine(int argc, char* argv[]);
+
     void askRunMode();
     void askParameters(); 
 
@@ -49,11 +66,18 @@ public:
     [[nodiscard]] double getS_max() const { return S_max; }
     [[nodiscard]] size_t getM() const { return M; }
     [[nodiscard]] size_t getN() const { return N; }
+    [[nodiscard]] double getTolerance() const { return tolerance; }
     
     // RENOMMÉ ICI AUSSI
     [[nodiscard]] double getThetaScheme() const { return theta_scheme; }
     
     [[nodiscard]] bool getIsCall() const { return isCall; }
+
+    [[nodiscard]] const std::string& getBatchInput() const { return batchInput; }
+    [[nodiscard]] const std::string& getBatchOutput() const { return batchOutput; }
+    [[nodiscard]] unsigned getBatchThreads() const { return batchThreads; }
+    [[nodiscard]] const std::string& getBatchStats() const { return batchStats; }
+    [[nodiscard]] bool getBatchSensitivities() const { return batchSensitivities; }
 };
 
 } // namespace edp
@@ -1,7 +1,9 @@
 #ifndef EDP_LINEARSOLVER_H
 #define EDP_LINEARSOLVER_H
 
+#include "edp/ThreadPool.h"
 #include <vector>
+#include <memory>
 #include <stdexcept> 
 
 namespace edp {
@@ -19,14 +21,288 @@ namespace edp {
      * @param c Vecteur de la diagonale supérieure (taille N). c[N-1] n'est pas utilisé.
      * @param d Vecteur du second membre (taille N).
      * @param x Vecteur résultat (taille N). La fonction redimensionnera si nécessaire.
+     * * Real : double ou float (instanciations explicites dans LinearSolver.cpp).
      * * @throw std::invalid_argument Si les tailles des vecteurs sont incohérentes.
      * @throw std::runtime_error Si le système est singulier (b[i] = 0 après pivot).
      */
-    void thomasAlgorithm(const std::vector<double>& a,
+    template <typename Real>
+    void thomasAlgorithm(const std::vector<Real>& a,
+                         const std::vector<Real>& b,
+                         const std::vector<Real>& c,
+                         const std::vector<Real>& d,
+                         std::vector<Real>& x);
+
+    /**
+     * @brief Tampons de travail de l'algorithme de Thomas, possédés par l'appelant.
+     * * Réutilisés d'un appel à l'autre : une fois dimensionnés, plus aucune allocation.
+     */
+    template <typename Real>
+    struct BasicThomasWorkspace {
+        std::vector<Real> c_prime;
+        std::vector<Real> d_prime;
+    };
+    using ThomasWorkspace = BasicThomasWorkspace<double>;
+
+    /**
+     * @brief Variante de thomasAlgorithm sans allocation (hors premier dimensionnement).
+     * * Même contrat que la version ci-dessus ; les copies de travail sont écrites
+     * dans ws au lieu d'être allouées à chaque appel.
+     */
+    template <typename Real>
+    void thomasAlgorithm(const std::vector<Real>& a,
+                         const std::vector<Real>& b,
+                         const std::vector<Real>& c,
+                         const std::vector<Real>& d,
+                         std::vector<Real>& x,
+                         BasicThomasWorkspace<Real>& ws);
+
+#define EDP_THOMAS_EXTERN(Real)                                                              \
+    extern template void thomasAlgorithm<Real>(const std::vector<Real>&, const std::vector<Real>&, \
+                                               const std::vector<Real>&, const std::vector<Real>&, \
+                                               std::vector<Real>&);                          \
+    extern template void thomasAlgorithm<Real>(const std::vector<Real>&, const std::vector<Real>&, \
+                                               const std::vector<Real>&, const std::vector<Real>&, \
+                                               std::vector<Real>&, BasicThomasWorkspace<Real>&);
+    EDP_THOMAS_EXTERN(double)
+    EDP_THOMAS_EXTERN(float)
+#undef EDP_THOMAS_EXTERN
+
+    /**
+     * @brief Jeux d'instructions vectorielles utilisables par thomasAlgorithmBatch.
+     */
+    enum class SimdLevel {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+
+    /**
+     * @brief Meilleur niveau SIMD supporté par le processeur courant (détecté à l'exécution).
+     */
+    [[nodiscard]] SimdLevel detectSimdLevel();
+
+    /**
+     * @brief Résout nsys systèmes tridiagonaux indépendants de même taille n.
+     * * Disposition entrelacée (structure de tableaux) : l'élément i du système j est
+     * rangé à l'indice i * nsys + j, pour a, b, c, d et x. La voie j d'un registre SIMD
+     * traite donc le système j ; chaque système a ses propres coefficients.
+     * * Le chemin AVX2/AVX-512 est choisi à l'exécution, avec repli scalaire. Les opérations
+     * sont celles de thomasAlgorithm, dans le même ordre : les résultats sont identiques
+     * bit à bit à nsys appels séparés.
+     * * @throw std::invalid_argument Si les tailles sont incohérentes.
+     * @throw std::runtime_error Si l'un des systèmes est singulier.
+     */
+    void thomasAlgorithmBatch(const std::vector<double>& a,
+                              const std::vector<double>& b,
+                              const std::vector<double>& c,
+                              const std::vector<double>& d,
+                              std::vector<double>& x,
+                              size_t nsys,
+                              ThomasWorkspace& ws);
+
+    /**
+     * @brief Variante imposant le niveau SIMD (ramené au niveau supporté si nécessaire).
+     */
+    void thomasAlgorithmBatch(const std::vector<double>& a,
+                              const std::vector<double>& b,
+                              const std::vector<double>& c,
+                              const std::vector<double>& d,
+                              std::vector<double>& x,
+                              size_t nsys,
+                              ThomasWorkspace& ws,
+                              SimdLevel level);
+
+    /**
+     * @brief Factorisation LU d'une matrice tridiagonale constante.
+     * * Lorsque la même matrice A est utilisée pour de nombreux seconds membres
+     * (boucle temporelle du theta-schéma), l'élimination des coefficients
+     * (c' et inverses des pivots) est faite une seule fois dans factorize().
+     * apply() ne fait plus que la descente sur d et la remontée : 2 multiplications
+     * et 2 soustractions par ligne, sans aucune division ni test de pivot.
+     * * En float, les boucles entrelacées traitent deux fois plus de seconds membres
+     * par registre SIMD (précisions Float et Mixed du solve par lot de PDESolver).
+     */
+    template <typename Real>
+    class BasicTridiagonalFactorization {
+    private:
+        std::vector<Real> lower;     // a : diagonale inférieure (inchangée par l'élimination)
+        std::vector<Real> c_prime;   // c'[i] = c[i] / pivot[i]
+        std::vector<Real> inv_pivot; // 1 / pivot[i]
+
+    public:
+        BasicTridiagonalFactorization() = default;
+
+        BasicTridiagonalFactorization(const std::vector<Real>& a,
+                                      const std::vector<Real>& b,
+                                      const std::vector<Real>& c) {
+            factorize(a, b, c);
+        }
+
+        /**
+         * @brief Élimination de Gauss sur les coefficients (a, b, c).
+         * @throw std::invalid_argument Si les tailles des vecteurs sont incohérentes.
+         * @throw std::runtime_error Si un pivot est nul.
+         */
+        void factorize(const std::vector<Real>& a,
+                       const std::vector<Real>& b,
+                       const std::vector<Real>& c);
+
+        /**
+         * @brief Reprend l'élimination à partir de la ligne first, les lignes [0, first)
+         * de (a, b, c) étant inchangées depuis la dernière factorisation (même taille).
+         * * Utile quand seule une plage de coefficients a changé : coût O(n - first).
+         * first = 0 équivaut à factorize().
+         * @throw std::invalid_argument Si la taille diffère de la factorisation courante.
+         * @throw std::runtime_error Si un pivot est nul.
+         */
+        void refactorize(const std::vector<Real>& a,
+                         const std::vector<Real>& b,
+                         const std::vector<Real>& c,
+                         size_t first);
+
+        /**
+         * @brief Résout A x = d avec la factorisation courante.
+         * * x peut être le même vecteur que d (résolution en place).
+         * @throw std::invalid_argument Si d n'a pas la taille du système.
+         */
+        void apply(const std::vector<Real>& d, std::vector<Real>& x) const;
+
+        /**
+         * @brief Résout A X = D pour nrhs seconds membres entrelacés.
+         * * L'élément i du second membre k est rangé en d[i * nrhs + k] : les boucles
+         * internes de descente et de remontée parcourent les seconds membres avec un pas unitaire.
+         * x peut être le même vecteur que d.
+         * @throw std::invalid_argument Si d n'a pas la taille size() * nrhs.
+         */
+        void applyInterleaved(const std::vector<Real>& d, std::vector<Real>& x,
+                              size_t nrhs) const;
+
+        [[nodiscard]] size_t size() const { return inv_pivot.size(); }
+
+        // Mémoire occupée par les coefficients factorisés (octets)
+        [[nodiscard]] size_t byteSize() const {
+            return (lower.capacity() + c_prime.capacity() + inv_pivot.capacity()) * sizeof(Real);
+        }
+    };
+    using TridiagonalFactorization = BasicTridiagonalFactorization<double>;
+    extern template class BasicTridiagonalFactorization<double>;
+    extern template class BasicTridiagonalFactorization<float>;
+
+    /**
+     * @brief Solveur tridiagonal parallèle par partition (type Wang / SPIKE).
+     * * Le système est découpé en P blocs séparés par P-1 lignes « séparatrices ».
+     * Chaque bloc ne couple qu'avec ses deux séparateurs : x = y + v * z_gauche + w * z_droite,
+     * où y est la solution locale et v, w les « spikes » (colonnes de couplage).
+     * Les séparateurs z vérifient un système tridiagonal réduit de taille P-1.
+     * * Spikes et système réduit ne dépendent que de A : ils sont calculés une fois
+     * dans factorize(). apply() fait en parallèle les descentes/remontées locales,
+     * résout le système réduit (O(P)), puis corrige chaque bloc en parallèle.
+     * Coût total ~2x Thomas, réparti sur P threads.
+     * * Les P-1 threads de travail sont permanents (ThreadPool créé par factorize(),
+     * conservé tant que P ne change pas) : apply() ne crée aucun thread et n'alloue rien ;
+     * la fin de chaque phase parallèle sert de barrière.
+     */
+    class PartitionedTridiagonalSolver {
+    private:
+        size_t n = 0;
+        std::vector<size_t> block_begin; // Début du bloc p (P+1 entrées, la dernière vaut n + 1)
+        std::vector<double> lower;       // a, conservée pour le second membre réduit
+        std::vector<double> upper;       // c
+        std::vector<double> c_prime;     // Élimination locale, redémarrée à chaque bloc
+        std::vector<double> inv_pivot;
+        std::vector<double> spike_left;  // v : réponse du bloc au séparateur de gauche
+        std::vector<double> spike_right; // w : réponse du bloc au séparateur de droite
+        TridiagonalFactorization reduced; // Système réduit sur les séparateurs
+        mutable std::vector<double> z;    // Séparateurs (second membre puis solution)
+        std::unique_ptr<ThreadPool> pool; // P threads au total, appelant compris (P > 1)
+        mutable const double* job_d = nullptr; // Second membre et solution de l'apply en cours
+        mutable double* job_x = nullptr;
+
+        void solveBlock(size_t p, const double* d, double* x) const;
+        void correctBlock(size_t p, double* x) const;
+
+    public:
+        PartitionedTridiagonalSolver() = default;
+
+        /**
+         * @brief Découpe et factorise A pour nThreads threads (au plus un bloc par thread).
+         * * Les blocs font au moins 64 lignes ; si un seul bloc est possible,
+         * apply() se ramène à l'algorithme de Thomas séquentiel.
+         * @throw std::invalid_argument Si les tailles sont incohérentes ou nThreads nul.
+         * @throw std::runtime_error Si un pivot local ou réduit est nul.
+         */
+        void factorize(const std::vector<double>& a,
+                       const std::vector<double>& b,
+                       const std::vector<double>& c,
+                       unsigned nThreads);
+
+        /**
+         * @brief Résout A x = d (x peut être le même vecteur que d).
+         */
+        void apply(const std::vector<double>& d, std::vector<double>& x) const;
+
+        [[nodiscard]] size_t size() const { return n; }
+        [[nodiscard]] size_t blocks() const { return block_begin.empty() ? 0 : block_begin.size() - 1; }
+    };
+
+    /**
+     * @brief Résolution ponctuelle de Ax = d avec le solveur partitionné sur nThreads threads.
+     * * Pour résoudre plusieurs seconds membres, factoriser une fois un PartitionedTridiagonalSolver.
+     */
+    void parallelThomasAlgorithm(const std::vector<double>& a,
+                                 const std::vector<double>& b,
+                                 const std::vector<double>& c,
+                                 const std::vector<double>& d,
+                                 std::vector<double>& x,
+                                 unsigned nThreads);
+
+    /**
+     * @brief Extrémité de la grille où se trouve la région d'exercice anticipé.
+     */
+    enum class ExerciseSide {
+        Low,  // Put américain : exercice pour les petits S
+        High  // Call (avec dividendes) : exercice pour les grands S
+    };
+
+    /**
+     * @brief Résout le problème de complémentarité linéaire (LCP)
+     *   A x >= d, x >= g, (A x - d)_i (x - g)_i = 0
+     * par l'algorithme de Brennan-Schwartz : élimination de Gauss depuis l'extrémité
+     * opposée à l'exercice, puis substitution depuis le côté de l'exercice avec
+     * projection x_i = max(g_i, ...). Coût O(N), le même que thomasAlgorithm.
+     * * Exact lorsque A est une M-matrice et que la région d'exercice est un seul
+     * intervalle contenant l'extrémité 'side'. Sinon, utiliser projectedSOR.
+     * * @param g Obstacle (valeur d'exercice), taille N.
+     * @throw std::invalid_argument Si les tailles sont incohérentes.
+     * @throw std::runtime_error Si un pivot est nul.
+     */
+    void brennanSchwartz(const std::vector<double>& a,
                          const std::vector<double>& b,
                          const std::vector<double>& c,
                          const std::vector<double>& d,
-                         std::vector<double>& x);
+                         const std::vector<double>& g,
+                         std::vector<double>& x,
+                         ThomasWorkspace& ws,
+                         ExerciseSide side);
+
+    /**
+     * @brief Même LCP par sur-relaxation projetée (PSOR), méthode itérative de référence.
+     * * x sert de point de départ (redimensionné et mis à g s'il n'a pas la taille N).
+     * Arrêt quand max_i |x_i^{k+1} - x_i^k| / max(1, |x_i^{k+1}|) < tolerance.
+     * Valable pour toute forme de région d'exercice.
+     * * @return Nombre d'itérations effectuées.
+     * @throw std::invalid_argument Si les tailles ou omega (hors ]0, 2[) sont incohérents.
+     * @throw std::runtime_error Si max_iter itérations ne suffisent pas.
+     */
+    size_t projectedSOR(const std::vector<double>& a,
+                        const std::vector<double>& b,
+                        const std::vector<double>& c,
+                        const std::vector<double>& d,
+                        const std::vector<double>& g,
+                        std::vector<double>& x,
+                        double omega = 1.2,
+                        double tolerance = 1e-10,
+                        size_t max_iter = 100000);
 
 } // namespace edp
 
@@ -0,0 +1,45 @@
+#ifndef EDP_LOCALVOLSURFACE_H
+#define EDP_LOCALVOLSURFACE_H
+
+#include <vector>
+#include <cstddef>
+
+namespace edp {
+
+    /*
+     * CLASSE LOCALVOLSURFACE
+     * Volatilité locale sigma(S, t) : tranches en temps calendaire constantes par morceaux
+     * (même convention que PiecewiseConstantCurve : la tranche k couvre ]times[k-1], times[k]],
+     * la dernière est prolongée), interpolation linéaire en S entre les noeuds de spot,
+     * plate au-delà. Sur une tranche, la surface est échantillonnée une seule fois sur
+     * la grille du solveur.
+     */
+    class LocalVolSurface {
+    private:
+        std::vector<double> times; // Fins de tranches, strictement croissantes et > 0
+        std::vector<double> spots; // Noeuds en S, strictement croissants
+        std::vector<double> vols;  // vols[k * spots.size() + j] : tranche k, spot j
+
+    public:
+        // @throw std::invalid_argument Si les tailles sont incohérentes, les noeuds non
+        //        strictement croissants ou une volatilité non positive.
+        LocalVolSurface(const std::vector<double>& times,
+                        const std::vector<double>& spots,
+                        const std::vector<double>& vols);
+
+        // Indice de la tranche contenant t
+        [[nodiscard]] size_t sliceIndex(double t) const;
+
+        // sigma(S[i], t) pour toute une grille S croissante (out redimensionné).
+        // Parcours conjoint des deux grilles triées : O(S.size() + spots.size()).
+        void sample(double t, const std::vector<double>& S, std::vector<double>& out) const;
+
+        // sigma(S, t) en un point
+        [[nodiscard]] double operator()(double S, double t) const;
+
+        [[nodiscard]] const std::vector<double>& getTimes() const { return times; }
+    };
+
+} // namespace edp
+
+#endif // EDP_LOCALVOLSURFACE_H
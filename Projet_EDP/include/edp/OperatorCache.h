@@ -0,0 +1,197 @@
+#ifndef EDP_OPERATORCACHE_H
+#define EDP_OPERATORCACHE_H
+
+#include "edp/Grid.h"
+#include "edp/LinearSolver.h"
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <utility>
+
+namespace edp {
+
+    // Grille préparée : noeuds ln(S) et S = exp(x), immuable une fois construite
+    struct PreparedGrid {
+        LogGrid grid;
+        std::vector<double> S;
+    };
+
+    // Opérateur du theta-schéma pour un pas donné : A, B, dL et factorisation de A.
+    // Immuable une fois construit : partagé sans copie entre solveurs et threads.
+    struct ThetaOperator {
+        std::vector<double> A_lower, A_diag, A_upper;
+        std::vector<double> B_lower, B_diag, B_upper;
+        std::vector<double> dLs_lower, dLs_diag, dLs_upper; // dt * dL/dsigma (vides sans sensibilités)
+        std::vector<double> dLr_lower, dLr_diag, dLr_upper; // dt * dL/dr
+        TridiagonalFactorization A_factor;
+    };
+
+    // Empreinte mémoire (octets) d'une entrée de cache : base du budget de LruCache
+    [[nodiscard]] size_t byteSize(const PreparedGrid& g);
+    [[nodiscard]] size_t byteSize(const ThetaOperator& op);
+
+    // Clé d'une grille : type, bornes, taille et paramètres d'étirement
+    struct GridKey {
+        GridType type = GridType::Uniform;
+        double x_min = 0.0, x_max = 0.0;
+        size_t N = 0;
+        double center = 0.0, alpha = 0.0;
+        std::vector<double> nodes; // Grille utilisateur uniquement
+
+        bool operator==(const GridKey& o) const {
+            return type == o.type && x_min == o.x_min && x_max == o.x_max && N == o.N
+                && center == o.center && alpha == o.alpha && nodes == o.nodes;
+        }
+    };
+
+    // Clé d'un opérateur : grille + modèle + pas (dt = T / M pour une grille uniforme) + schéma
+    struct OperatorKey {
+        GridKey grid;
+        double r = 0.0, sigma = 0.0;
+        double step = 0.0, theta = 0.0;
+        bool sensitivities = false;
+
+        bool operator==(const OperatorKey& o) const {
+            return grid == o.grid && r == o.r && sigma == o.sigma && step == o.step
+                && theta == o.theta && sensitivities == o.sensitivities;
+        }
+    };
+
+    struct GridKeyHash {
+        size_t operator()(const GridKey& k) const;
+    };
+
+    struct OperatorKeyHash {
+        size_t operator()(const OperatorKey& k) const;
+    };
+
+    /*
+     * CLASSE LRUCACHE
+     * Cache borné, thread-safe, des objets les plus récemment utilisés.
+     * Deux bornes : nombre d'entrées et budget en octets (byteSize de chaque valeur,
+     * mesurée à l'insertion) ; les entrées les plus anciennes sont évincées jusqu'à
+     * respecter les deux. Une valeur plus grosse que le budget n'est pas conservée.
+     * Les valeurs sont partagées (shared_ptr vers const) : une entrée évincée reste
+     * valide pour les solveurs qui l'utilisent encore.
+     * La construction d'une valeur manquante se fait hors verrou.
+     */
+    template <typename Key, typename Value, typename Hash>
+    class LruCache {
+    private:
+        using Entry = std::pair<Key, std::shared_ptr<const Value>>;
+
+        mutable std::mutex mutex;
+        size_t capacity;
+        size_t capacity_bytes;
+        std::list<Entry> entries; // Plus récent en tête
+        std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+        size_t byte_count = 0;
+        size_t hit_count = 0;
+        size_t miss_count = 0;
+
+        void evict() {
+            while (!entries.empty() && (entries.size() > capacity || byte_count > capacity_bytes)) {
+                byte_count -= byteSize(*entries.back().second);
+                index.erase(entries.back().first);
+                entries.pop_back();
+            }
+        }
+
+    public:
+        LruCache(size_t capacity_, size_t capacity_bytes_)
+            : capacity(capacity_), capacity_bytes(capacity_bytes_) {}
+
+        // Valeur associée à key, construite par build() (shared_ptr<const Value>) si absente
+        template <typename Builder>
+        std::shared_ptr<const Value> getOrBuild(const Key& key, Builder&& build) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = index.find(key);
+                if (it != index.end()) {
+                    entries.splice(entries.begin(), entries, it->second);
+                    ++hit_count;
+                    return it->second->second;
+                }
+                ++miss_count;
+            }
+
+            std::shared_ptr<const Value> value = build();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = index.find(key);
+            if (it != index.end()) {
+                // Construit entre-temps par un autre thread : on garde la première version
+                return it->second->second;
+            }
+            entries.emplace_front(key, value);
+            index.emplace(key, entries.begin());
+            byte_count += byteSize(*value);
+            evict();
+            return value;
+        }
+
+        void setCapacity(size_t capacity_) {
+            std::lock_guard<std::mutex> lock(mutex);
+            capacity = capacity_;
+            evict();
+        }
+
+        void setCapacityBytes(size_t capacity_bytes_) {
+            std::lock_guard<std::mutex> lock(mutex);
+            capacity_bytes = capacity_bytes_;
+            evict();
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.clear();
+            index.clear();
+            byte_count = 0;
+            hit_count = 0;
+            miss_count = 0;
+        }
+
+        [[nodiscard]] size_t hits() const { std::lock_guard<std::mutex> lock(mutex); return hit_count; }
+        [[nodiscard]] size_t misses() const { std::lock_guard<std::mutex> lock(mutex); return miss_count; }
+        [[nodiscard]] size_t size() const { std::lock_guard<std::mutex> lock(mutex); return entries.size(); }
+        [[nodiscard]] size_t bytes() const { std::lock_guard<std::mutex> lock(mutex); return byte_count; }
+    };
+
+    /*
+     * CLASSE OPERATORCACHE
+     * Cache partagé par tous les PDESolver : grilles préparées (exp des noeuds)
+     * et opérateurs factorisés. Deux solveurs aux mêmes paramètres (T, r, sigma,
+     * S_max, theta, N, M, grille) ne refont aucun travail de préparation.
+     * Seuls les opérateurs réutilisables y entrent : les pas uniques (pas adaptatifs
+     * ou géométriques) et les volatilités d'une itération (PDESolver::setShareOperators)
+     * sont assemblés par le solveur sans passer par le cache.
+     */
+    class OperatorCache {
+    private:
+        OperatorCache();
+
+    public:
+        LruCache<GridKey, PreparedGrid, GridKeyHash> grids;
+        LruCache<OperatorKey, ThetaOperator, OperatorKeyHash> operators;
+
+        static OperatorCache& instance();
+
+        OperatorCache(const OperatorCache&) = delete;
+        OperatorCache& operator=(const OperatorCache&) = delete;
+
+        // Nombre maximal d'entrées de chaque cache (défaut : 32 grilles, 64 opérateurs)
+        void setCapacity(size_t grid_capacity, size_t operator_capacity);
+
+        // Budget mémoire de chaque cache en octets (défaut : 16 Mo de grilles, 64 Mo d'opérateurs)
+        void setCapacityBytes(size_t grid_bytes, size_t operator_bytes);
+
+        // Vide les deux caches et remet les compteurs à zéro
+        void clear();
+    };
+
+} // namespace edp
+
+#endif // EDP_OPERATORCACHE_H
@@ -2,17 +2,51 @@
 #define EDP_PDESOLVER_H
 
 #include "edp/Payoff.h" 
+#include "edp/LinearSolver.h"
+#include "edp/SolutionSlice.h"
+#include "edp/Grid.h"
+#include "edp/OperatorCache.h"
+#include "edp/TermStructure.h"
+#include "edp/LocalVolSurface.h"
+#include "edp/SolveStats.h"
 #include <vector>
 #include <cstddef>      
+#include <type_traits>
+#include <memory>
 
 namespace edp {
 
-    // Structure pour les résultats financiers
-    struct PricingResults {
-        double price;  // V (Prix)
-        double delta;  // dV/dS
-        double gamma;  // d2V/dS2
-        double theta;  // dV/dt (Grecque temporelle)
+    // Grille temporelle du theta-schéma
+    enum class TimeStepping {
+        Uniform,   // M pas égaux (comportement historique)
+        Geometric, // M pas croissants géométriquement depuis la maturité
+        Adaptive   // Pas choisi d'après la variation relative de la solution
+    };
+
+    // Style d'exercice
+    enum class ExerciseStyle {
+        European,
+        American
+    };
+
+    // Résolution du problème à obstacle (exercice anticipé)
+    enum class AmericanMethod {
+        Auto,            // Brennan-Schwartz si le payoff est monotone, PSOR sinon
+        BrennanSchwartz, // Direct, O(N) par pas
+        PSOR             // Itératif, toute forme de région d'exercice
+    };
+
+    // Précision de la résolution par lot
+    enum class Precision {
+        Double, // Tout en double (comportement historique)
+        Float,  // Pas de temps en float : deux fois plus de contrats par registre SIMD
+        Mixed   // Pas en float + correction de défaut en double (écart au double ~1e-7)
+    };
+
+    // Frontière d'exercice à un instant (temps restant jusqu'à maturité)
+    struct ExerciseBoundaryPoint {
+        double time; // Temps jusqu'à maturité
+        double S;    // Spot critique (0 : aucun noeud exercé)
     };
 
     class PDESolver {
@@ -28,29 +62,361 @@ namespace edp {
 
         // Pas de discrétisation
         double dt;
-        double dx;
+        double dx;           // Pas en ln(S) (grille uniforme ; 0 sinon)
+
+        // Opérateur courant : A = Matrice Implicite (Future), B = Matrice Explicite (Passée),
+        // dL et factorisation de A. Partagé via le cache (cached_op), ou assemblé
+        // dans own_op (stocké pour éviter la réallocation) si le cache est désactivé,
+        // si les opérateurs ne sont pas partagés ou si le pas n'est pas uniforme.
+        // Refait seulement quand le pas ou le schéma change.
+        const ThetaOperator* op = nullptr;
+        std::shared_ptr<const ThetaOperator> cached_op;
+        ThetaOperator own_op;
+        OperatorKey op_key;
+        bool use_cache = true;
+        bool share_operators = true;
+        double op_dt = 0.0;      // Pas de l'opérateur assemblé
+        double op_theta = -1.0;  // Schéma de l'opérateur assemblé
+        double op_r = 0.0, op_sigma = 0.0; // Coefficients de l'opérateur assemblé
+
+        // Structure par terme r(t), sigma(t) (nulles : r et sigma scalaires)
+        std::shared_ptr<const PiecewiseConstantCurve> rate_curve, vol_curve;
+        // Segments en temps restant : fins, coefficients, pas (grille uniforme)
+        std::vector<double> segment_ends, segment_r, segment_sigma;
+        std::vector<size_t> segment_steps;
+        double cur_r = 0.0, cur_sigma = 0.0; // Coefficients du segment courant
+
+        // Volatilité locale sigma(S, t), échantillonnée sur la grille une fois par tranche
+        std::shared_ptr<const LocalVolSurface> local_vol;
+        std::vector<double> lv_sigma, lv_sample;         // Échantillon courant / nouveau (taille N)
+        size_t lv_dirty_begin = 0, lv_dirty_end = 0;     // Noeuds modifiés depuis le dernier assemblage
+        const PreparedGrid* geometry_grid = nullptr;     // Grille de la géométrie ci-dessous
+        std::vector<double> geo_d1l, geo_d1d, geo_d1u;   // D1 par ligne
+        std::vector<double> geo_d2l, geo_d2d, geo_d2u;   // D2 par ligne
+        size_t assembled_rows = 0;
+        size_t factorizations = 0;
+
+        // Grille temporelle : démarrage de Rannacher et pas variables
+        size_t rannacher_steps = 0;  // Premiers pas remplacés par deux demi-pas implicites
+        TimeStepping time_stepping = TimeStepping::Uniform;
+        double time_growth = 1.0;    // Raison de la grille géométrique
+        double step_target = 0.1;    // Variation relative visée par pas (mode adaptatif)
+        size_t steps_taken = 0;      // Pas effectués au dernier solve
+        double last_dt = 0.0;        // Dernier pas (pour le Theta)
+
+        // Solveur parallèle, utilisé à la place de A_factor pour les grandes grilles
+        PartitionedTridiagonalSolver A_parallel;
+        size_t parallel_threshold;  // Taille de système (N-2) à partir de laquelle on parallélise
+        unsigned parallel_threads;  // Nombre de threads du solveur partitionné
+        bool use_parallel = false;
+
+        // Exercice anticipé : projection V >= payoff à chaque pas
+        ExerciseStyle exercise_style = ExerciseStyle::European;
+        AmericanMethod american_method = AmericanMethod::Auto;
+        ExerciseSide exercise_side = ExerciseSide::Low;
+        bool use_psor = false;
+        std::vector<double> obstacle;  // Payoff aux noeuds intérieurs (taille N-2)
+        ThomasWorkspace exercise_ws;
+        std::vector<ExerciseBoundaryPoint> exercise_boundary;
+
+        void prepareExercise();
+        void solveExercise();
+        void recordExerciseBoundary(double time_next);
+
+        // Vega et Rho par équations tangentes (dérivées du theta-schéma)
+        bool compute_sensitivities = false;
+        std::vector<double> U_sigma, U_r;                   // dV/dsigma, dV/dr (taille N)
+        std::vector<double> d_sigma, d_r;                   // Seconds membres tangents (taille N-2)
+
+        // Variable de contrôle analytique : on résout l'écart E = V - V_BS au prix de
+        // Black-Scholes (r, sigma du constructeur). E part de 0 à maturité et suit
+        // dE/dtau = L E + (L - L_BS) V_BS, terme source moyenné sur les cellules.
+        bool cv_active = false;
+        bool cv_is_call = true;
+        double cv_K = 0.0;
+        std::shared_ptr<const PreparedGrid> cv_grid; // Grille des faces ci-dessous
+        std::vector<double> cv_x, cv_S;             // Faces des cellules (milieux, taille N-1)
+        std::vector<double> cv_price, cv_delta;     // V_BS et Delta_BS aux faces
+        std::vector<double> cv_source;              // Source aux noeuds intérieurs (taille N-2)
+
+        // Source (L - L_BS) V_BS au temps restant tau, dans cv_source (false : source nulle)
+        bool controlVariateSource(double tau);
+
+        // Grille et vecteurs de travail, conservés entre deux appels à solve()
+        // (N et M étant fixés à la construction, l'état stable ne fait aucune allocation)
+        // Grille logarithmique x = ln(S) et S = exp(x) (évite les exp() répétés),
+        // partagées via le cache
+        std::shared_ptr<const PreparedGrid> prepared;
+        GridKey grid_key;
+        std::vector<double> V;       // Solution courante (taille N)
+        std::vector<double> V_prev;  // Avant-dernière tranche, pour le Theta (taille N)
+        std::vector<double> d;       // Second membre du système linéaire (taille N-2)
+        std::vector<double> V_solve; // Résultat du solveur linéaire (taille N-2)
+
+        // Espaces de travail du solve par lot (entrelacés : indice i * K + k)
+        std::vector<double> V_batch, V_batch_prev, d_batch, V_batch_solve;
+        std::vector<double> payoff_values; // Payoff d'un contrat du lot sur la grille (taille N)
+        std::vector<double> payoff_bounds; // Payoffs aux bornes [bas(K) | haut(K)]
+
+        // Lot en précision réduite : copie float de l'opérateur courant,
+        // solution float, solution suivante et correction (Mixed), entrelacées comme V_batch
+        Precision precision = Precision::Double;
+        bool float_op_stale = true;
+        std::vector<float> Af_lower, Af_diag, Af_upper, Bf_lower, Bf_diag, Bf_upper;
+        BasicTridiagonalFactorization<float> A_factor_f;
+        std::vector<float> Vf_batch, Vf_next, Ef_batch, df_batch;
+
+        void refreshFloatOperator();
+        double advanceBatchReduced(size_t K, bool adaptive);
+        void materializeBatch(size_t K);
+        std::vector<double> V_bounds;      // Valeurs de Dirichlet [gauche(K) | droite(K)]
+
+        // Valeurs de Dirichlet aux bornes de la grille à l'instant time_next
+        void boundaryValues(double payoff_low, double payoff_high, double time_next,
+                            double& V_left, double& V_right) const;
+
+        // Installe une grille et redimensionne les espaces de travail
+        void setGrid(const GridKey& key);
+
+        // Opérateur pour un pas 'step' au schéma 'theta' (cache ou assemblage)
+        void assembleOperator(double step, double theta);
+        // Assemble A, B (et dL) puis factorise A
+        void buildOperator(double step, double theta, ThetaOperator& out) const;
+        // Volatilité locale : assemblage incrémental dans own_op
+        void assembleLocalVol(double step, double theta);
+        void sampleLocalVol(double t);
+        void prepareOperator(double step, double theta);
+
+        // Pas de temps : premier pas et pas suivant selon le mode
+        [[nodiscard]] double initialStep() const;
+        [[nodiscard]] double nextStep(double h, double change) const;
+
+        // Segments de la structure par terme et actualisation intégrée
+        void prepareSegments();
+        [[nodiscard]] double discountExponent(double tau) const;
+
+        // Boucle temporelle commune aux solves simple et par lot
+        template <typename AdvanceFn>
+        void timeLoop(AdvanceFn&& advance);
+
+        // Dérivées par rapport à r des valeurs de Dirichlet (équation tangente du Rho)
+        void boundaryRhoValues(double payoff_low, double payoff_high, double time_next,
+                               double& dV_left, double& dV_right) const;
+
+        // Solution à t = 0 du dernier solve (réutilisée : pas d'allocation en régime stable)
+        SolutionSlice slice;
+
+        // Statistiques (EDP_ENABLE_STATS) : solve en cours (y compris la grille installée
+        // avant lui), dernier solve terminé et cumul. Capacités des espaces de travail au
+        // solve précédent, pour compter les réallocations.
+        SolveStats stats, last_stats, total_stats;
+        PhaseClock phase_clock{stats};
+        size_t factorizations_mark = 0;
+        std::vector<size_t> workspace_capacity;
 
-        // Vecteurs coefficients (stockés pour éviter la réallocation)
-        // A = Matrice Implicite (Future), B = Matrice Explicite (Passée)
-        std::vector<double> B_lower, B_diag, B_upper; 
-        std::vector<double> A_lower, A_diag, A_upper; 
+        // Clôt les statistiques du solve : contracts contrats de N noeuds propagés ensemble
+        void finishStats(size_t contracts);
+
+        // Lot européen : remontée commune puis tranche du contrat k (dans 'slice')
+        void marchBatch(const std::vector<const Payoff*>& payoffs);
+        void loadBatchSlice(size_t k, size_t K);
+
+        // Boucle temporelle à partir de la condition terminale déjà écrite dans V.
+        // Indépendant du type de payoff ; le résultat est chargé dans 'slice'.
+        void march();
 
     public:
         PDESolver(double T, double r, double sigma, 
                   double S_max, double theta_scheme, 
                   size_t N, size_t M);
 
+        // Réinitialise les paramètres du constructeur en conservant les options
+        // (cache, sensibilités, exercice, courbes...) et les espaces de travail.
+        // Grille uniforme sur [S_min, S_max] (S_min = 0 : S_max / 3000), reconstruite
+        // seulement si le domaine ou N changent.
+        void reset(double T, double r, double sigma, double S_max, double theta_scheme,
+                   size_t N, size_t M, double S_min = 0.0);
+
         // Interdiction de la copie 
         PDESolver(const PDESolver&) = delete;
         PDESolver& operator=(const PDESolver&) = delete;
 
-        // Pré-calcul des matrices (indépendant du Payoff)
+        // Cache partagé des grilles et opérateurs factorisés (activé par défaut).
+        // Désactivé : tout est recalculé par ce solveur (grille déjà installée conservée).
+        void setUseCache(bool enabled);
+
+        // Opérateurs hors du cache partagé (grilles toujours partagées) : pour les
+        // paramètres qui ne resserviront pas, p. ex. une volatilité par itération d'un
+        // solveur de volatilité implicite. Sans objet hors du pas uniforme, dont les
+        // opérateurs ne sont jamais mis en cache.
+        void setShareOperators(bool enabled);
+
+        // Grille uniforme en ln(S) sur [S_min, S_max] (même N) au lieu de [S_max / 3000, S_max].
+        // Domaine automatique : voir chooseDomain (GridSizing.h).
+        void setDomain(double S_min, double S_max);
+
+        // Grille non uniforme en ln(S), étirée par sinh autour de S_center (strike ou spot).
+        // Mêmes bornes et même N ; alpha (en ln(S)) règle la concentration (ex. 0.1).
+        void setSinhGrid(double S_center, double alpha);
+
+        // Grille fournie par l'utilisateur : noeuds en S, strictement croissants.
+        // N devient S_nodes.size() et S_max le dernier noeud.
+        void setGridNodes(const std::vector<double>& S_nodes);
+
+        // Vega et Rho calculés pendant la même remontée en temps, par les équations
+        // tangentes du schéma (même A factorisée, deux seconds membres de plus par pas).
+        // Désactivé par défaut : Vega et Rho valent alors 0. Le Theta est toujours calculé.
+        void setComputeSensitivities(bool enabled);
+
+        // Solveur linéaire parallèle au-delà de 'threshold' inconnues (défaut : 100 000).
+        // nThreads = 0 : nombre de cœurs de la machine.
+        void setParallelThreshold(size_t threshold, unsigned nThreads = 0);
+        [[nodiscard]] size_t getParallelThreshold() const { return parallel_threshold; }
+        [[nodiscard]] unsigned getParallelThreads() const { return parallel_threads; }
+
+        // Exercice européen (défaut) ou américain. En américain, chaque pas résout
+        // A V = d sous la contrainte V >= payoff (Brennan-Schwartz, O(N), ou PSOR).
+        void setExerciseStyle(ExerciseStyle style, AmericanMethod method = AmericanMethod::Auto);
+
+        // Frontière d'exercice du dernier solve américain, un point par pas de temps
+        [[nodiscard]] const std::vector<ExerciseBoundaryPoint>& getExerciseBoundary() const {
+            return exercise_boundary;
+        }
+
+        // Structure par terme constante par morceaux (temps calendaire, 0 = aujourd'hui).
+        // A, B et la factorisation sont calculés une fois par segment ; les pas de temps
+        // tombent sur les noeuds. Les bornes de Dirichlet utilisent l'actualisation intégrée.
+        // Vega et Rho deviennent les sensibilités à un déplacement parallèle des courbes.
+        void setRateCurve(const PiecewiseConstantCurve& curve);
+        void setVolatilityCurve(const PiecewiseConstantCurve& curve);
+
+        // Volatilité locale sigma(S, t) (remplace sigma et la courbe de volatilité).
+        // Chaque tranche est échantillonnée sur la grille ; seules les lignes dont la
+        // volatilité change d'une tranche à l'autre sont réassemblées, une tranche
+        // identique à la précédente réutilise l'opérateur. Pas de cache partagé dans ce mode.
+        void setLocalVolatility(const LocalVolSurface& surface);
+
+        // Démarrage de Rannacher : les 'steps' premiers pas (2 conseillé) sont remplacés
+        // chacun par deux demi-pas totalement implicites. Amortit les oscillations de
+        // Crank-Nicolson dues au coin du payoff (Gamma propre près du strike).
+        void setRannacherSteps(size_t steps);
+
+        // Grille temporelle (défaut : uniforme, M pas)
+        void setUniformTimeGrid();
+        // M pas, petits près de la maturité : dt_{k+1} = growth * dt_k (growth >= 1)
+        void setGeometricTimeGrid(double growth);
+        // Pas adaptatif : chaque pas vise une variation relative max 'target_change'
+        // de la solution ; M ne sert qu'au pas initial (0.1 * T / M)
+        void setAdaptiveTimeGrid(double target_change);
+
+        // Diagnostics du dernier solve : nombre de pas et factorisations cumulées
+        // (faites par ce solveur ; un opérateur lu dans le cache n'est pas compté)
+        [[nodiscard]] size_t getStepCount() const { return steps_taken; }
+        [[nodiscard]] size_t getFactorizationCount() const { return factorizations; }
+        // Lignes d'opérateur assemblées en volatilité locale (cumul)
+        [[nodiscard]] size_t getAssembledRowCount() const { return assembled_rows; }
+
+        // Temps par phase et compteurs du dernier solve, et leur cumul sur la vie du solveur.
+        // Collectés seulement si la librairie est compilée avec EDP_ENABLE_STATS
+        // (SolveStats::enabled) ; sinon tout reste à 0.
+        [[nodiscard]] const SolveStats& getSolveStats() const { return last_stats; }
+        [[nodiscard]] const SolveStats& getCumulativeStats() const { return total_stats; }
+
+        // Précision de la résolution par lot (défaut : Double). Float : A, B et la
+        // solution en float (prix à ~1e-3 du double). Mixed : même pas en float, plus
+        // l'équation de l'erreur A E^{n+1} = B E^n + (B V^n - A V^{n+1}), défaut calculé
+        // en double et résolu en float ; seul subsiste l'arrondi float de E (prix à ~1e-7
+        // du double). Coût : un second solve float et un produit double par pas, soit
+        // 1,1 à 3 fois le temps du lot en double (EDP_Bench, batch/) : mode de précision,
+        // pas de débit.
+        // Les contrats américains et les solves individuels restent en double.
+        void setPrecision(Precision p) { precision = p; }
+        [[nodiscard]] Precision getPrecision() const { return precision; }
+
+        // Pré-calcul des matrices (indépendant du Payoff) pour le premier pas, et factorisation de A
         void precomputeMatrices();
 
-        // Résolution : Prend S0 pour interpoler le résultat final
+        // Résolution : Prend S0 pour interpoler le résultat final.
+        // Version polymorphe (CLI) : un seul appel virtuel, Payoff::evaluate sur la grille.
         [[nodiscard]] PricingResults solve(const Payoff& payoff, double S0);
+
+        // Version spécialisée à la compilation : PayoffT est tout type appelable
+        // double(double) (PayoffCall, PayoffPut, lambda...). Le payoff est inliné
+        // dans la boucle de condition terminale, sans dispatch virtuel.
+        template <typename PayoffT,
+                  std::enable_if_t<std::is_invocable_r_v<double, const PayoffT&, double>, int> = 0>
+        [[nodiscard]] PricingResults solve(const PayoffT& payoff, double S0);
+
+        /**
+         * @brief Call ou put européen de strike K, résolu en écart au prix de Black-Scholes.
+         * * Le r et le sigma du constructeur servent de modèle de référence ; la structure
+         * par terme ou la volatilité locale éventuelle est le modèle résolu. Seul l'écart
+         * V - V_BS est discrétisé (condition terminale nulle, sans le coin du payoff) puis
+         * le prix, le Delta, le Gamma et le Theta fermés sont rajoutés au spot.
+         * Modèle égal à la référence : prix de Black-Scholes exact, quelle que soit la grille.
+         * Vega et Rho valent 0.
+         * @throw std::logic_error Exercice américain ou sensibilités tangentes activées.
+         */
+        [[nodiscard]] PricingResults solveControlVariate(bool is_call, double K, double S0);
+
+        // Résolution complète : renvoie la solution à t = 0 sur toute la grille.
+        // Un seul solve pour évaluer ensuite une échelle de spots (SolutionSlice::evaluate).
+        [[nodiscard]] SolutionSlice solveSlice(const Payoff& payoff);
+
+        template <typename PayoffT,
+                  std::enable_if_t<std::is_invocable_r_v<double, const PayoffT&, double>, int> = 0>
+        [[nodiscard]] SolutionSlice solveSlice(const PayoffT& payoff);
+
+        // Résolution par lot : tous les payoffs partagent la grille, A et B.
+        // Les conditions terminales sont propagées ensemble (système multi-seconds membres).
+        // Renvoie un PricingResults par contrat, interpolé en spots[k].
+        [[nodiscard]] std::vector<PricingResults> solve(const std::vector<const Payoff*>& payoffs,
+                                                        const std::vector<double>& spots);
+
+        // Même résolution par lot, mais renvoie la tranche complète de chaque contrat
+        // (out[k], redimensionné ; capacité réutilisée d'un appel à l'autre).
+        void solveSlices(const std::vector<const Payoff*>& payoffs, std::vector<SolutionSlice>& out);
     };
 
+    template <typename PayoffT,
+              std::enable_if_t<std::is_invocable_r_v<double, const PayoffT&, double>, int>>
+    PricingResults PDESolver::solve(const PayoffT& payoff, double S0) {
+        phase_clock.restart();
+        precomputeMatrices();
+        phase_clock.lap(SolvePhase::Operator);
+
+        // Condition Terminale (Payoff à t=T) : boucle unique, payoff inliné
+        const std::vector<double>& S = prepared->S;
+        for (size_t i = 0; i < N; ++i) {
+            V[i] = payoff(S[i]);
+        }
+        phase_clock.lap(SolvePhase::Payoff);
+
+        march();
+        PricingResults result = slice.evaluate(S0, Interpolation::Linear);
+        phase_clock.lap(SolvePhase::Interpolation);
+        finishStats(1);
+        return result;
+    }
+
+    template <typename PayoffT,
+              std::enable_if_t<std::is_invocable_r_v<double, const PayoffT&, double>, int>>
+    SolutionSlice PDESolver::solveSlice(const PayoffT& payoff) {
+        phase_clock.restart();
+        precomputeMatrices();
+        phase_clock.lap(SolvePhase::Operator);
+
+        const std::vector<double>& S = prepared->S;
+        for (size_t i = 0; i < N; ++i) {
+            V[i] = payoff(S[i]);
+        }
+        phase_clock.lap(SolvePhase::Payoff);
+
+        march();
+        finishStats(1);
+        return slice;
+    }
+
 } // namespace edp
 
 #endif // EDP_PDESOLVER_H
\ No newline at end of file
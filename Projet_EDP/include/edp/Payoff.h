@@ -2,13 +2,17 @@
 #define EDP_PAYOFF_H
 
 #include <algorithm> // Pour std::max
+#include <vector>
+#include <cstddef>
 
 namespace edp {
 
     /*
      * CLASSE PAYOFF 
      * Contrat : Définit le flux financier à maturité.
-     * Utilisation : Header-only pour maximiser l'inlining lors des boucles de calcul.
+     * Utilisation : Header-only ; les classes concrètes sont 'final', de sorte que
+     * PDESolver::solve<PayoffT> appelle operator() sans dispatch virtuel et l'inline.
+     * Via une référence Payoff&, evaluate() ne coûte qu'un appel virtuel par grille.
      */
     class Payoff {
     public:
@@ -17,10 +21,19 @@ namespace edp {
         
         // Opérateur pur pour calcul du payoff
         [[nodiscard]] virtual double operator()(double spot) const = 0;
+
+        // Évaluation sur toute une grille : out[i] = payoff(S[i])
+        // (redimensionne out si nécessaire)
+        virtual void evaluate(const std::vector<double>& S, std::vector<double>& out) const {
+            out.resize(S.size());
+            for (size_t i = 0; i < S.size(); ++i) {
+                out[i] = (*this)(S[i]);
+            }
+        }
     };
 
     // --- Implémentation du CALL ---
-    class PayoffCall : public Payoff {
+    class PayoffCall final : public Payoff {
     private:
         double K; // Strike price
     public:
@@ -29,10 +42,18 @@ namespace edp {
         [[nodiscard]] double operator()(double spot) const override {
             return std::max(spot - K, 0.0);
         }
+
+        // Boucle sans appel virtuel : vectorisable par le compilateur
+        void evaluate(const std::vector<double>& S, std::vector<double>& out) const override {
+            out.resize(S.size());
+            for (size_t i = 0; i < S.size(); ++i) {
+                out[i] = std::max(S[i] - K, 0.0);
+            }
+        }
     };
 
     // --- Implémentation du PUT ---
-    class PayoffPut : public Payoff {
+    class PayoffPut final : public Payoff {
     private:
         double K; // Strike price
     public:
@@ -41,6 +62,14 @@ namespace edp {
         [[nodiscard]] double operator()(double spot) const override {
             return std::max(K - spot, 0.0);
         }
+
+        // Boucle sans appel virtuel : vectorisable par le compilateur
+        void evaluate(const std::vector<double>& S, std::vector<double>& out) const override {
+            out.resize(S.size());
+            for (size_t i = 0; i < S.size(); ++i) {
+                out[i] = std::max(K - S[i], 0.0);
+            }
+        }
     };
 
 } // namespace edp
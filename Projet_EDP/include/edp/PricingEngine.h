@@ -0,0 +1,122 @@
+#ifndef EDP_PRICINGENGINE_H
+#define EDP_PRICINGENGINE_H
+
+#include "edp/PDESolver.h"
+#include "edp/GridSizing.h"
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <functional>
+
+namespace edp {
+
+    // Un contrat vanille européen et les paramètres de sa grille
+    struct Contract {
+        bool is_call = true;
+        double S0 = 0.0, K = 0.0, T = 0.0, r = 0.0, sigma = 0.0;
+        double S_max = 0.0;       // 0 : 4 * K (suggestion de l'interface)
+        double theta = 0.5;       // Theta-schéma
+        size_t N = 200, M = 100;  // Pas d'espace / de temps
+        // Grille automatique (tous les moteurs, via gridFor) : S_max ignoré si domain_std > 0
+        // ou tolerance > 0, N et M ignorés si tolerance > 0 (voir GridSizing.h)
+        double domain_std = 0.0;  // > 0 : domaine à domain_std écarts-types autour du forward
+        double tolerance = 0.0;   // > 0 : erreur visée sur le prix (domaine à 5 écarts-types par défaut)
+    };
+
+    // Grille effective d'un contrat : fixe [S_max / 3000, S_max] ou automatique.
+    // Avec tolerance > 0, achievable = false signale une grille plafonnée (N_max, M_max)
+    // dont l'erreur estimée (estimated_error) dépasse la tolérance demandée.
+    // @throw std::invalid_argument Si la grille automatique est demandée pour un contrat invalide.
+    [[nodiscard]] GridChoice gridFor(const Contract& c);
+
+    /*
+     * CLASSE PRICINGENGINE
+     * Pricing concurrent sur un pool de threads à vol de tâches.
+     * Chaque worker possède son PDESolver (réinitialisé par reset() d'un contrat à
+     * l'autre, espaces de travail conservés) et sa file : il dépile ses propres tâches
+     * par la fin et vole les autres files par le début quand la sienne est vide.
+     * Les contrats d'une même grille (domaine, N) sont envoyés dans la file du même
+     * worker, de sorte que grille, opérateur et factorisation restent chauds ;
+     * le vol rééquilibre la charge si une grille domine.
+     * Parallélisme imbriqué borné : le solveur partitionné d'un worker (grands N)
+     * n'utilise que sa part des cœurs (cœurs / workers, au moins 1).
+     */
+    class PricingEngine {
+    private:
+        struct Worker;
+        using Task = std::function<void(Worker&)>;
+
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+            std::unique_ptr<PDESolver> solver; // Créé au premier contrat
+            std::thread thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        bool sensitivities;
+        unsigned solver_threads = 1;       // Threads du solveur linéaire partitionné par worker
+
+        std::mutex idle_mutex;
+        std::condition_variable idle;
+        std::atomic<size_t> queued{0};     // Tâches en file (toutes files confondues)
+        std::atomic<size_t> steals{0};
+        bool stopping = false;
+
+        void workerLoop(size_t index);
+        bool popLocal(Worker& w, Task& task);
+        bool steal(size_t thief, Task& task);
+        void push(size_t worker, Task task);
+        void pushMany(size_t worker, std::vector<Task>& batch);
+        [[nodiscard]] size_t affinity(const GridChoice& g) const;
+
+        PricingResults priceOn(Worker& w, const Contract& c, const GridChoice& g) const;
+
+    public:
+        // nThreads = 0 : nombre de cœurs. sensitivities : Vega et Rho par équations tangentes
+        // (deux seconds membres de plus par pas ; sinon vega et rho valent 0).
+        explicit PricingEngine(unsigned nThreads = 0, bool sensitivities = false);
+        ~PricingEngine();
+
+        PricingEngine(const PricingEngine&) = delete;
+        PricingEngine& operator=(const PricingEngine&) = delete;
+
+        [[nodiscard]] size_t size() const { return workers.size(); }
+
+        // Threads du solveur linéaire parallèle de chaque worker (part des cœurs)
+        [[nodiscard]] unsigned getSolverThreads() const { return solver_threads; }
+
+        // Un contrat, de façon asynchrone. Une erreur (paramètres invalides, grille
+        // automatique impossible...) est relancée par future::get().
+        [[nodiscard]] std::future<PricingResults> submit(const Contract& contract);
+
+        // Tout un lot, bloquant. Les contrats sont triés par grille puis par opérateur
+        // et découpés en paquets ; résultats dans l'ordre d'entrée.
+        // @throw La première erreur rencontrée, une fois le lot terminé.
+        [[nodiscard]] std::vector<PricingResults> priceAll(const std::vector<Contract>& contracts);
+
+        // Variante sans allocation du résultat : out[i] pour contracts[i].
+        // errors non nul : message par contrat (vide si succès), sans exception.
+        // grids non nul : grille utilisée pour chaque contrat (automatique ou non) ;
+        // grids[i].achievable = false : prix calculé sans atteindre la tolérance du contrat.
+        void priceAll(const Contract* contracts, size_t count, PricingResults* out,
+                      std::string* errors = nullptr, GridChoice* grids = nullptr);
+
+        // Cumul des statistiques des solveurs des workers (EDP_ENABLE_STATS).
+        // À appeler hors de tout lot en cours (après priceAll, futures obtenus).
+        [[nodiscard]] SolveStats getSolveStats() const;
+
+        // Paquets exécutés par un autre worker que celui de leur grille (cumul)
+        [[nodiscard]] size_t getStealCount() const { return steals.load(); }
+    };
+
+} // namespace edp
+
+#endif // EDP_PRICINGENGINE_H
@@ -0,0 +1,45 @@
+#ifndef EDP_RICHARDSON_H
+#define EDP_RICHARDSON_H
+
+#include "edp/Payoff.h"
+#include "edp/SolutionSlice.h"
+#include <cstddef>
+
+namespace edp {
+
+    // Paramètres du mode "précision cible"
+    struct ToleranceOptions {
+        size_t N0 = 41;          // Grille grossière (espace) ; raffinée en (N0 - 1) * 2^l + 1
+        size_t M0 = 20;          // Grille grossière (temps) ; raffinée en M0 * 2^l
+        size_t max_levels = 8;   // Nombre maximal de grilles (coût x4 par niveau)
+        double S_center = 0.0;   // Centre de la grille sinh (strike conseillé ; 0 = spot S0)
+        double alpha = 0.1;      // Concentration de la grille sinh (en ln(S))
+        bool parallel = true;    // Trois premières grilles résolues sur des threads séparés
+    };
+
+    // Résultat : prix extrapolé, estimation d'erreur et grille la plus fine utilisée
+    struct ToleranceResult {
+        PricingResults results;  // Prix extrapolé ; Grecques de la grille la plus fine
+        double error_estimate;   // Estimation de l'erreur absolue sur le prix
+        double order;            // Ordre de convergence observé
+        size_t N, M;             // Grille la plus fine
+        size_t levels;           // Nombre de grilles résolues
+        bool converged;          // error_estimate <= tolerance
+    };
+
+    /*
+     * EXTRAPOLATION DE RICHARDSON
+     * Résout une grille grossière puis ses raffinements (N et M doublés à chaque niveau)
+     * jusqu'à ce que l'erreur estimée passe sous 'tolerance'.
+     * Ordre p observé sur trois niveaux : p = log2(|P1 - P0| / |P2 - P1|), borné à [1, 4].
+     * Prix extrapolé : E = P2 + (P2 - P1) / (2^p - 1) ; erreur estimée : |E - E_précédent|.
+     */
+    [[nodiscard]] ToleranceResult solveToTolerance(const Payoff& payoff, double S0,
+                                                   double T, double r, double sigma,
+                                                   double S_max, double theta_scheme,
+                                                   double tolerance,
+                                                   const ToleranceOptions& options = ToleranceOptions());
+
+} // namespace edp
+
+#endif // EDP_RICHARDSON_H
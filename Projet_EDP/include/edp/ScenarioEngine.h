@@ -0,0 +1,83 @@
+#ifndef EDP_SCENARIOENGINE_H
+#define EDP_SCENARIOENGINE_H
+
+#include "edp/PricingEngine.h"
+#include "edp/ThreadPool.h"
+#include <vector>
+#include <cstddef>
+
+namespace edp {
+
+    // Grille de stress : chaque scénario combine un choc de volatilité et un choc de spot
+    struct ScenarioGrid {
+        std::vector<double> spot_shocks; // Relatifs : S0 * (1 + s)
+        std::vector<double> vol_shocks;  // Absolus : sigma + dv
+
+        [[nodiscard]] size_t size() const { return spot_shocks.size() * vol_shocks.size(); }
+        // Indice du scénario (choc de vol v, choc de spot s)
+        [[nodiscard]] size_t index(size_t v, size_t s) const { return v * spot_shocks.size() + s; }
+    };
+
+    struct ScenarioOptions {
+        // Interpolation de la tranche t = 0, prix de base et spots choqués.
+        // Linear : mêmes prix que PricingEngine (PDESolver::solve) ; Cubic : P&L plus lisse en spot
+        Interpolation interpolation = Interpolation::Linear;
+    };
+
+    // P&L contrats x scénarios : une ligne contiguë par contrat, scénarios dans l'ordre de
+    // ScenarioGrid::index (chocs de spot consécutifs pour une même volatilité)
+    struct ScenarioResults {
+        size_t contracts = 0;
+        size_t scenarios = 0;
+        std::vector<double> base; // Prix sans choc, par contrat
+        std::vector<double> pnl;  // pnl[k * scenarios + j] = prix choqué - base[k]
+
+        [[nodiscard]] double operator()(size_t contract, size_t scenario) const {
+            return pnl[contract * scenarios + scenario];
+        }
+        [[nodiscard]] const double* row(size_t contract) const { return pnl.data() + contract * scenarios; }
+    };
+
+    /*
+     * CLASSE SCENARIOENGINE
+     * Reprice un portefeuille sur une grille de chocs spot x vol.
+     * - Choc de spot : aucune résolution de plus, la tranche t = 0 est évaluée
+     *   aux spots choqués (interpolation de ScenarioOptions, la même pour le prix de base).
+     * - Choc de vol : les contrats de même grille, maturité, taux et volatilité forment
+     *   un groupe ; chaque couple (groupe, volatilité choquée) est un seul solve par lot
+     *   (un opérateur, une factorisation, tous les payoffs du groupe ensemble).
+     * Les couples (groupe, volatilité) sont répartis sur les threads.
+     * Nombre de solves : groupes x chocs de vol (+ groupes si 0 n'est pas un choc de vol),
+     * au lieu de contrats x scénarios.
+     */
+    class ScenarioEngine {
+    private:
+        ThreadPool pool;
+        ScenarioOptions options;
+        size_t solves = 0;
+
+    public:
+        // nThreads : threads au total, appelant compris (0 = nombre de cœurs)
+        explicit ScenarioEngine(unsigned nThreads = 0, const ScenarioOptions& opts = ScenarioOptions());
+
+        ScenarioEngine(const ScenarioEngine&) = delete;
+        ScenarioEngine& operator=(const ScenarioEngine&) = delete;
+
+        /**
+         * @brief P&L de chaque contrat sous chaque scénario.
+         * * out est redimensionné (capacité réutilisée d'un appel à l'autre).
+         * @throw std::invalid_argument Contrat invalide, volatilité choquée non positive,
+         * spot choqué hors de ]S_min, S_max[ de la grille du contrat (gridFor, fixe ou
+         * automatique à la volatilité sans choc), ou grille automatique impossible.
+         */
+        void run(const std::vector<Contract>& portfolio, const ScenarioGrid& grid, ScenarioResults& out);
+
+        [[nodiscard]] ScenarioResults run(const std::vector<Contract>& portfolio, const ScenarioGrid& grid);
+
+        // Solves par lot effectués au dernier run
+        [[nodiscard]] size_t getSolveCount() const { return solves; }
+    };
+
+} // namespace edp
+
+#endif // EDP_SCENARIOENGINE_H
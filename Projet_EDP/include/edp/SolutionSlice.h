@@ -0,0 +1,74 @@
+#ifndef EDP_SOLUTIONSLICE_H
+#define EDP_SOLUTIONSLICE_H
+
+#include "edp/Grid.h"
+#include <vector>
+#include <cstddef>
+
+namespace edp {
+
+    // Structure pour les résultats financiers (toujours en double, y compris pour
+    // les solves par lot en précision Float / Mixed : seul le pas de temps change de type)
+    struct PricingResults {
+        double price;  // V (Prix)
+        double delta;  // dV/dS
+        double gamma;  // d2V/dS2
+        double theta;  // dV/dt (Grecque temporelle)
+        double vega;   // dV/dsigma (0 si les sensibilités ne sont pas calculées)
+        double rho;    // dV/dr
+    };
+
+    // Schéma d'interpolation de la solution entre les noeuds de la grille
+    enum class Interpolation {
+        Linear,  // Prix linéaire, Grecques par différences finies au noeud (comportement historique)
+        Cubic,   // Lagrange 4 points, Grecques dérivées du polynôme au spot exact
+        Quintic  // Lagrange 6 points
+    };
+
+    /*
+     * CLASSE SOLUTIONSLICE
+     * Solution V(x) à t = 0 sur toute la grille logarithmique x = ln(S).
+     * Un seul solve PDE suffit ensuite pour évaluer prix, Delta et Gamma
+     * en autant de spots que nécessaire (échelle de spots pour le risque).
+     * Sur grille uniforme ou sinh, l'indice d'un spot s'obtient en O(1).
+     */
+    class SolutionSlice {
+    private:
+        LogGrid grid;          // Noeuds ln(S)
+        std::vector<double> V; // Valeurs aux noeuds
+        // Grecques nodales optionnelles (vide = non disponible, renvoyée à 0)
+        std::vector<double> Theta, Vega, Rho;
+
+        [[nodiscard]] PricingResults evaluateLinear(double S0) const;
+        template <size_t P>
+        [[nodiscard]] PricingResults evaluateLagrange(double S0) const;
+
+    public:
+        SolutionSlice() = default;
+
+        // Copie la grille et la solution. Réutilise la capacité déjà allouée :
+        // aucune allocation si la taille ne change pas.
+        // Les Grecques nodales précédentes sont effacées.
+        void assign(const LogGrid& nodes, const std::vector<double>& values);
+
+        // Grecques nodales (même taille que la solution), interpolées comme le prix
+        void assignTheta(const std::vector<double>& values);
+        void assignVega(const std::vector<double>& values);
+        void assignRho(const std::vector<double>& values);
+
+        [[nodiscard]] size_t size() const { return V.size(); }
+        [[nodiscard]] const std::vector<double>& nodes() const { return grid.nodes(); }
+        [[nodiscard]] const LogGrid& getGrid() const { return grid; }
+        [[nodiscard]] const std::vector<double>& values() const { return V; }
+
+        // Prix et Grecques en un spot
+        [[nodiscard]] PricingResults evaluate(double S0, Interpolation method = Interpolation::Cubic) const;
+
+        // Prix et Grecques pour toute une échelle de spots (out est redimensionné)
+        void evaluate(const std::vector<double>& spots, std::vector<PricingResults>& out,
+                      Interpolation method = Interpolation::Cubic) const;
+    };
+
+} // namespace edp
+
+#endif // EDP_SOLUTIONSLICE_H
@@ -0,0 +1,98 @@
+#ifndef EDP_SOLVESTATS_H
+#define EDP_SOLVESTATS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Collecte des statistiques de solve : activée par l'option CMake EDP_ENABLE_STATS.
+// Désactivée (défaut), les chronomètres sont vides et les compteurs ne sont jamais
+// mis à jour : aucun coût dans la boucle temporelle.
+#ifndef EDP_ENABLE_STATS
+#define EDP_ENABLE_STATS 0
+#endif
+
+namespace edp {
+
+    // Phases d'un solve PDE
+    enum class SolvePhase {
+        Grid,          // Construction de la grille (exp() des noeuds) et des espaces de travail
+        Operator,      // Assemblage de A, B et factorisation de A (ou lecture du cache)
+        Payoff,        // Condition terminale
+        Boundary,      // Valeurs de Dirichlet (actualisation)
+        Rhs,           // Second membre B V^n
+        LinearSolve,   // Descente/remontée (ou projection américaine)
+        Update,        // Recopie de la solution, variation adaptative, frontière d'exercice
+        Sensitivities, // Équations tangentes (Vega, Rho), leurs deux résolutions comprises
+        Interpolation, // Tranche finale et Grecques au spot
+        Count
+    };
+
+    constexpr size_t kSolvePhaseCount = static_cast<size_t>(SolvePhase::Count);
+
+    /*
+     * STRUCTURE SOLVESTATS
+     * Temps par phase et compteurs d'un ou plusieurs solves (cumulables par +=).
+     * allocations : réallocations des espaces de travail du solveur et grilles /
+     * opérateurs construits par lui (les résultats renvoyés ne sont pas comptés).
+     */
+    struct SolveStats {
+        static constexpr bool enabled = (EDP_ENABLE_STATS != 0);
+
+        std::array<uint64_t, kSolvePhaseCount> phase_ns{};
+        size_t solves = 0;
+        size_t steps = 0;
+        size_t node_steps = 0;     // Somme des N x pas (N : noeuds de la grille)
+        size_t factorizations = 0;
+        size_t allocations = 0;
+
+        [[nodiscard]] uint64_t totalNs() const;
+        [[nodiscard]] uint64_t phaseNs(SolvePhase p) const { return phase_ns[static_cast<size_t>(p)]; }
+        [[nodiscard]] double nodeStepsPerSecond() const;
+
+        SolveStats& operator+=(const SolveStats& other);
+
+        // CSV "metric,value" : une ligne par phase (ns et part du total) puis les compteurs
+        void writeCsv(std::ostream& out) const;
+    };
+
+    [[nodiscard]] const char* phaseName(SolvePhase p);
+
+    /*
+     * CLASSE PHASECLOCK
+     * Chronomètre par tours : lap(p) impute à la phase p le temps écoulé depuis
+     * le tour précédent (ou restart()). Vide si EDP_ENABLE_STATS vaut 0.
+     */
+#if EDP_ENABLE_STATS
+    class PhaseClock {
+    private:
+        using Clock = std::chrono::steady_clock;
+        SolveStats& stats;
+        Clock::time_point last;
+
+    public:
+        explicit PhaseClock(SolveStats& s) : stats(s), last(Clock::now()) {}
+
+        void restart() { last = Clock::now(); }
+
+        void lap(SolvePhase p) {
+            Clock::time_point now = Clock::now();
+            stats.phase_ns[static_cast<size_t>(p)] += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count());
+            last = now;
+        }
+    };
+#else
+    class PhaseClock {
+    public:
+        explicit PhaseClock(SolveStats&) {}
+        void restart() {}
+        void lap(SolvePhase) {}
+    };
+#endif
+
+} // namespace edp
+
+#endif // EDP_SOLVESTATS_H
@@ -0,0 +1,41 @@
+#ifndef EDP_TERMSTRUCTURE_H
+#define EDP_TERMSTRUCTURE_H
+
+#include <vector>
+#include <cstddef>
+
+namespace edp {
+
+    /*
+     * CLASSE PIECEWISECONSTANTCURVE
+     * Courbe constante par morceaux en temps calendaire t (0 = aujourd'hui).
+     * values[k] s'applique sur ]knots[k-1], knots[k]] (knots[-1] = 0) ;
+     * la dernière valeur est prolongée au-delà du dernier noeud.
+     * Sert aux structures par terme r(t) et sigma(t) de PDESolver.
+     */
+    class PiecewiseConstantCurve {
+    private:
+        std::vector<double> knots;  // Fins de segments, strictement croissantes et > 0
+        std::vector<double> values;
+
+    public:
+        // Courbe plate (aucun noeud, pas de segment dans la grille temporelle)
+        explicit PiecewiseConstantCurve(double value);
+
+        // @throw std::invalid_argument Si les tailles diffèrent, sont nulles, ou si les noeuds
+        //        ne sont pas strictement croissants et positifs.
+        PiecewiseConstantCurve(const std::vector<double>& knots, const std::vector<double>& values);
+
+        // Valeur sur le segment contenant t (continuité à gauche aux noeuds)
+        [[nodiscard]] double value(double t) const;
+
+        // Intégrale de la courbe entre t0 et t1 (t0 <= t1)
+        [[nodiscard]] double integral(double t0, double t1) const;
+
+        [[nodiscard]] const std::vector<double>& getKnots() const { return knots; }
+        [[nodiscard]] const std::vector<double>& getValues() const { return values; }
+    };
+
+} // namespace edp
+
+#endif // EDP_TERMSTRUCTURE_H
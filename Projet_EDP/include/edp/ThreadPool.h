@@ -0,0 +1,62 @@
+#ifndef EDP_THREADPOOL_H
+#define EDP_THREADPOOL_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+namespace edp {
+
+    /*
+     * CLASSE THREADPOOL
+     * Threads permanents pour les boucles parallèles courtes et répétées
+     * (une par demi-pas ADI) : aucun thread n'est créé après la construction.
+     * parallelFor découpe [0, count) en tranches de grain indices, distribuées
+     * dynamiquement ; le thread appelant participe au calcul.
+     * Une seule boucle à la fois : parallelFor n'est pas réentrant.
+     */
+    class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+
+        std::mutex run_mutex;              // Sérialise les appels à parallelFor
+        std::mutex mutex;
+        std::condition_variable wake;      // Nouvelle boucle ou arrêt
+        std::condition_variable done;      // Fin de participation des workers
+
+        const std::function<void(size_t, size_t)>* job = nullptr;
+        size_t job_count = 0;
+        size_t job_grain = 1;
+        std::atomic<size_t> next{0};       // Prochain indice à distribuer
+        size_t pending = 0;                // Workers encore dans la boucle courante
+        std::uint64_t generation = 0;
+        bool stopping = false;
+        std::exception_ptr error;          // Première exception levée par une tranche
+
+        void workerLoop();
+        void runChunks();
+
+    public:
+        // nThreads : threads au total, appelant compris (0 = nombre de cœurs)
+        explicit ThreadPool(unsigned nThreads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] size_t size() const { return workers.size() + 1; }
+
+        // Appelle fn(begin, end) sur des tranches disjointes couvrant [0, count).
+        // Bloquant ; relance dans l'appelant la première exception d'une tranche.
+        void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+    };
+
+} // namespace edp
+
+#endif // EDP_THREADPOOL_H
@@ -0,0 +1,281 @@
+#include "edp/BatchPricer.h"
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define EDP_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace edp {
+
+namespace {
+
+    constexpr char kBinaryMagic[8] = {'E', 'D', 'P', 'B', 'I', 'N', '1', '\0'};
+
+    std::string_view trim(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+        return s;
+    }
+
+    // Champ suivant (séparateur ',') ; line est avancée après le séparateur
+    std::string_view nextField(std::string_view& line) {
+        size_t comma = line.find(',');
+        std::string_view field = line.substr(0, comma);
+        line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+        return trim(field);
+    }
+
+    [[noreturn]] void parseError(size_t line, const char* what) {
+        throw std::runtime_error("Erreur Batch: ligne " + std::to_string(line) + " : " + what);
+    }
+
+    template <typename T>
+    T parseNumber(std::string_view field, size_t line) {
+        T value{};
+        auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+        if (ec != std::errc() || ptr != field.data() + field.size()) {
+            parseError(line, "valeur numerique invalide.");
+        }
+        return value;
+    }
+
+    // call/put, C/P ou 1/0 ; -1 si non reconnu
+    int parseType(std::string_view field) {
+        if (field == "call" || field == "Call" || field == "CALL" || field == "C" || field == "c" || field == "1") return 1;
+        if (field == "put" || field == "Put" || field == "PUT" || field == "P" || field == "p" || field == "0") return 0;
+        return -1;
+    }
+
+    // Champ texte CSV entre guillemets (guillemets internes doublés) : les messages
+    // d'erreur contiennent des virgules
+    void writeQuoted(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char ch : text) {
+            if (ch == '"') out << '"';
+            out << ch;
+        }
+        out << '"';
+    }
+
+    template <typename T>
+    T readRaw(const char* p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T)); // Enregistrements non alignés
+        return value;
+    }
+
+    template <typename T>
+    void writeRaw(std::ostream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+} // namespace
+
+// --- MappedFile ---
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef EDP_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Erreur Batch: Impossible d'ouvrir " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Erreur Batch: Impossible de lire la taille de " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Erreur Batch: Projection en memoire impossible pour " + path);
+        }
+        ::madvise(p, size_, MADV_SEQUENTIAL);
+        begin_ = static_cast<const char*>(p);
+    }
+    ::close(fd); // La projection reste valide
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Erreur Batch: Impossible d'ouvrir " + path);
+    }
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    begin_ = fallback.data();
+    size_ = fallback.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef EDP_HAS_MMAP
+    if (begin_ && size_ > 0) {
+        ::munmap(const_cast<char*>(begin_), size_);
+    }
+#endif
+}
+
+// --- ContractReader ---
+
+ContractReader::ContractReader(const MappedFile& file) : ContractReader(file.data(), file.size()) {}
+
+ContractReader::ContractReader(const char* data, size_t size) : cursor(data), end(data + size) {
+    if (size >= sizeof(kBinaryMagic) && std::memcmp(data, kBinaryMagic, sizeof(kBinaryMagic)) == 0) {
+        binary = true;
+        cursor += sizeof(kBinaryMagic);
+        if (static_cast<size_t>(end - cursor) % kBinaryRecordSize != 0) {
+            throw std::runtime_error("Erreur Batch: Fichier binaire tronque.");
+        }
+    }
+}
+
+bool ContractReader::next(Contract& c) {
+    return binary ? nextBinary(c) : nextCsv(c);
+}
+
+bool ContractReader::nextCsv(Contract& c) {
+    while (cursor < end) {
+        const char* eol = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if (!eol) eol = end;
+        std::string_view rest = trim(std::string_view(cursor, static_cast<size_t>(eol - cursor)));
+        cursor = (eol < end) ? eol + 1 : end;
+        ++line;
+
+        if (rest.empty() || rest.front() == '#') continue;
+
+        std::string_view type_field = nextField(rest);
+        int type = parseType(type_field);
+        if (type < 0) {
+            // En-tête de colonnes
+            if (type_field == "type" || type_field == "Type") continue;
+            parseError(line, "type de contrat inconnu (call/put attendu).");
+        }
+
+        c = Contract();
+        c.is_call = (type == 1);
+        double* required[] = {&c.S0, &c.K, &c.T, &c.r, &c.sigma};
+        for (double* field : required) {
+            if (rest.empty()) parseError(line, "champs manquants (type,S0,K,T,r,sigma attendus).");
+            *field = parseNumber<double>(nextField(rest), line);
+        }
+        if (!rest.empty()) c.S_max = parseNumber<double>(nextField(rest), line);
+        if (!rest.empty()) c.N = parseNumber<size_t>(nextField(rest), line);
+        if (!rest.empty()) c.M = parseNumber<size_t>(nextField(rest), line);
+        if (!rest.empty()) c.theta = parseNumber<double>(nextField(rest), line);
+        if (!rest.empty()) c.tolerance = parseNumber<double>(nextField(rest), line);
+        if (!rest.empty()) parseError(line, "champs en trop.");
+        return true;
+    }
+    return false;
+}
+
+bool ContractReader::nextBinary(Contract& c) {
+    if (cursor >= end) return false;
+    const char* p = cursor;
+    cursor += kBinaryRecordSize;
+    ++line;
+
+    std::uint32_t type = readRaw<std::uint32_t>(p);
+    if (type > 1) parseError(line, "type de contrat inconnu.");
+    c.is_call = (type == 1);
+    c.N = readRaw<std::uint32_t>(p + 4);
+    c.M = readRaw<std::uint32_t>(p + 8);
+    c.S0    = readRaw<double>(p + 16);
+    c.K     = readRaw<double>(p + 24);
+    c.T     = readRaw<double>(p + 32);
+    c.r     = readRaw<double>(p + 40);
+    c.sigma = readRaw<double>(p + 48);
+    c.S_max = readRaw<double>(p + 56);
+    c.theta = readRaw<double>(p + 64);
+    return true;
+}
+
+void writeBinaryHeader(std::ostream& out) {
+    out.write(kBinaryMagic, sizeof(kBinaryMagic));
+}
+
+void writeBinaryContract(std::ostream& out, const Contract& c) {
+    writeRaw<std::uint32_t>(out, c.is_call ? 1u : 0u);
+    writeRaw<std::uint32_t>(out, static_cast<std::uint32_t>(c.N));
+    writeRaw<std::uint32_t>(out, static_cast<std::uint32_t>(c.M));
+    writeRaw<std::uint32_t>(out, 0u);
+    for (double v : {c.S0, c.K, c.T, c.r, c.sigma, c.S_max, c.theta}) {
+        writeRaw<double>(out, v);
+    }
+}
+
+// --- Pricing par paquets ---
+
+BatchStats priceBatch(ContractReader& reader, std::ostream& out, const BatchOptions& options) {
+    const size_t chunk_size = std::max<size_t>(options.chunk_size, 1);
+    PricingEngine engine(options.threads, options.sensitivities);
+
+    // Tampons d'un paquet, réutilisés d'un paquet à l'autre
+    std::vector<Contract> contracts(chunk_size);
+    std::vector<PricingResults> results(chunk_size);
+    std::vector<std::string> errors(chunk_size);
+    std::vector<GridChoice> grids(chunk_size);
+    std::vector<std::string> read_errors(chunk_size);
+
+    BatchStats stats;
+    auto t0 = std::chrono::steady_clock::now();
+    out << "index,price,delta,gamma,theta,vega,rho,status\n";
+
+    char buffer[256];
+    for (;;) {
+        // Ligne mal formée : erreur de la ligne, lecture reprise à la suivante. Le contrat
+        // vide laissé à sa place est rejeté par le moteur sans solve
+        size_t n = 0;
+        for (; n < chunk_size; ++n) {
+            read_errors[n].clear();
+            try {
+                if (!reader.next(contracts[n])) break;
+            } catch (const std::runtime_error& e) {
+                contracts[n] = Contract(); // S0 = 0 : invalide
+                read_errors[n] = e.what();
+            }
+        }
+        if (n == 0) break;
+
+        // Tri par grille et répartition entre workers faits par le moteur
+        engine.priceAll(contracts.data(), n, results.data(), errors.data(), grids.data());
+
+        // Écriture dans l'ordre du fichier
+        for (size_t i = 0; i < n; ++i) {
+            size_t index = stats.contracts + i;
+            if (!read_errors[i].empty()) errors[i] = read_errors[i];
+            if (errors[i].empty()) {
+                const PricingResults& res = results[i];
+                const bool achieved = grids[i].achievable;
+                if (!achieved) ++stats.unachieved;
+                int len = std::snprintf(buffer, sizeof(buffer), "%zu,%.10g,%.10g,%.10g,%.10g,%.10g,%.10g,%s\n",
+                                        index, res.price, res.delta, res.gamma, res.theta, res.vega, res.rho,
+                                        achieved ? "ok" : "tolerance_non_atteinte");
+                out.write(buffer, len);
+            } else {
+                ++stats.failed;
+                out << index << ",,,,,,,";
+                writeQuoted(out, "erreur: " + errors[i]);
+                out << '\n';
+            }
+        }
+        stats.contracts += n;
+    }
+    out.flush();
+
+    stats.solver = engine.getSolveStats();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return stats;
+}
+
+} // namespace edp
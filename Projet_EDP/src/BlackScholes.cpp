@@ -0,0 +1,119 @@
+#include "edp/BlackScholes.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace edp {
+
+double normalCdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+double normalPdf(double x) {
+    return 0.3989422804014327 * std::exp(-0.5 * x * x); // 1/sqrt(2 pi)
+}
+
+double blackScholesPrice(bool is_call, double S0, double K, double T, double r, double sigma) {
+    double discount = std::exp(-r * T);
+    if (!(T > 0.0) || !(sigma > 0.0)) {
+        return is_call ? std::max(S0 - K * discount, 0.0) : std::max(K * discount - S0, 0.0);
+    }
+    double vol_sqrtT = sigma * std::sqrt(T);
+    double d1 = (std::log(S0 / K) + (r + 0.5 * sigma * sigma) * T) / vol_sqrtT;
+    double d2 = d1 - vol_sqrtT;
+    if (is_call) {
+        return S0 * normalCdf(d1) - K * discount * normalCdf(d2);
+    }
+    return K * discount * normalCdf(-d2) - S0 * normalCdf(-d1);
+}
+
+PricingResults blackScholesGreeks(bool is_call, double S0, double K, double T, double r, double sigma) {
+    double sqrtT = std::sqrt(T);
+    double vol_sqrtT = sigma * sqrtT;
+    double d1 = (std::log(S0 / K) + (r + 0.5 * sigma * sigma) * T) / vol_sqrtT;
+    double d2 = d1 - vol_sqrtT;
+    double discount = std::exp(-r * T);
+    double pdf = normalPdf(d1);
+
+    double gamma = pdf / (S0 * vol_sqrtT);
+    double vega  = S0 * pdf * sqrtT;
+    if (is_call) {
+        double price = S0 * normalCdf(d1) - K * discount * normalCdf(d2);
+        double theta = -S0 * pdf * sigma / (2.0 * sqrtT) - r * K * discount * normalCdf(d2);
+        return {price, normalCdf(d1), gamma, theta, vega, K * T * discount * normalCdf(d2)};
+    }
+    double price = K * discount * normalCdf(-d2) - S0 * normalCdf(-d1);
+    double theta = -S0 * pdf * sigma / (2.0 * sqrtT) + r * K * discount * normalCdf(-d2);
+    return {price, -normalCdf(-d1), gamma, theta, vega, -K * T * discount * normalCdf(-d2)};
+}
+
+void blackScholesAtSpots(bool is_call, const double* S, const double* log_S, size_t n,
+                         double K, double T, double r, double sigma,
+                         double* price, double* delta) {
+    const double discounted_K = K * std::exp(-r * T);
+    const double w = is_call ? 1.0 : -1.0;
+
+    // Maturité atteinte : valeur intrinsèque
+    if (!(T > 0.0) || !(sigma > 0.0)) {
+        for (size_t i = 0; i < n; ++i) {
+            price[i] = std::max(w * (S[i] - discounted_K), 0.0);
+            if (delta) delta[i] = (S[i] > discounted_K ? 1.0 : 0.0) - (is_call ? 0.0 : 1.0);
+        }
+        return;
+    }
+
+    const double vol_sqrtT = sigma * std::sqrt(T);
+    const double inv_vol = 1.0 / vol_sqrtT;
+    const double drift = (r + 0.5 * sigma * sigma) * T - std::log(K);
+    const double inv_sqrt2 = 1.0 / std::sqrt(2.0);
+
+    // w = +1 (call) ou -1 (put) : w [S N(w d1) - K e^{-rT} N(w d2)], formule directe
+    // des deux côtés (pas de parité, qui perd tous les chiffres d'un put loin hors de la monnaie)
+    for (size_t i = 0; i < n; ++i) {
+        double x = log_S ? log_S[i] : std::log(S[i]);
+        double d1 = (x + drift) * inv_vol;
+        double d2 = d1 - vol_sqrtT;
+        double N1 = 0.5 * std::erfc(-w * d1 * inv_sqrt2);
+        double N2 = 0.5 * std::erfc(-w * d2 * inv_sqrt2);
+        price[i] = w * (S[i] * N1 - discounted_K * N2);
+        if (delta) delta[i] = w * N1;
+    }
+}
+
+double blackScholesVega(double S0, double K, double T, double r, double sigma) {
+    double sqrtT = std::sqrt(T);
+    double d1 = (std::log(S0 / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * sqrtT);
+    return S0 * normalPdf(d1) * sqrtT;
+}
+
+double blackScholesImpliedVol(bool is_call, double price, double S0, double K, double T, double r) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    if (!(S0 > 0.0) || !(K > 0.0) || !(T > 0.0)) return nan;
+
+    // Put ramené au call par la parité
+    double discounted_K = K * std::exp(-r * T);
+    double call = is_call ? price : price + S0 - discounted_K;
+    double lower = std::max(S0 - discounted_K, 0.0);
+    if (!(call > lower) || !(call < S0)) return nan;
+
+    // Départ au point d'inflexion du prix en sigma : Newton y converge de façon monotone
+    double sigma = std::sqrt(2.0 * std::fabs(std::log(S0 / discounted_K)) / T);
+    if (!(sigma > 1e-3)) sigma = 0.2;
+    double lo = 0.0, hi = 10.0;
+
+    for (int it = 0; it < 100; ++it) {
+        double diff = blackScholesPrice(true, S0, K, T, r, sigma) - call;
+        if (diff > 0.0) hi = sigma; else lo = sigma;
+
+        double vega = blackScholesVega(S0, K, T, r, sigma);
+        double next = sigma - diff / vega;
+        if (!(vega > 0.0) || !(next > lo) || !(next < hi)) {
+            next = 0.5 * (lo + hi); // Pas de Newton hors de l'encadrement : bissection
+        }
+        if (std::fabs(next - sigma) < 1e-14 * std::max(1.0, sigma)) return next;
+        sigma = next;
+    }
+    return sigma;
+}
+
+} // namespace edp
@@ -0,0 +1,99 @@
+#include "edp/Grid.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace edp {
+
+LogGrid LogGrid::uniform(double x_min, double x_max, size_t N) {
+    if (N < 6 || !(x_max > x_min)) {
+        throw std::invalid_argument("Erreur Grille: Bornes invalides ou moins de 6 noeuds.");
+    }
+
+    LogGrid g;
+    g.type = GridType::Uniform;
+    g.x_min = x_min;
+    g.step = (x_max - x_min) / static_cast<double>(N - 1);
+    g.x.resize(N);
+    for (size_t i = 0; i < N; ++i) {
+        g.x[i] = x_min + i * g.step;
+    }
+    return g;
+}
+
+LogGrid LogGrid::sinh(double x_min, double x_max, size_t N, double x_center, double alpha) {
+    if (N < 6 || !(x_max > x_min)) {
+        throw std::invalid_argument("Erreur Grille: Bornes invalides ou moins de 6 noeuds.");
+    }
+    if (!(alpha > 0.0)) {
+        throw std::invalid_argument("Erreur Grille: Parametre de concentration alpha non positif.");
+    }
+
+    // Étirement de Tavella-Randall : xi uniforme dans [c1, c2],
+    // x = center + alpha * sinh(xi). Pas fin autour de center, large aux bords.
+    LogGrid g;
+    g.type = GridType::Sinh;
+    g.center = x_center;
+    g.alpha = alpha;
+    g.c1 = std::asinh((x_min - x_center) / alpha);
+    double c2 = std::asinh((x_max - x_center) / alpha);
+    g.step = (c2 - g.c1) / static_cast<double>(N - 1);
+
+    g.x.resize(N);
+    for (size_t i = 0; i < N; ++i) {
+        g.x[i] = x_center + alpha * std::sinh(g.c1 + i * g.step);
+    }
+    // Bornes exactes (pas d'erreur d'arrondi sur le domaine)
+    g.x[0] = x_min;
+    g.x[N - 1] = x_max;
+    return g;
+}
+
+LogGrid LogGrid::custom(const std::vector<double>& nodes) {
+    if (nodes.size() < 6) {
+        throw std::invalid_argument("Erreur Grille: Au moins 6 noeuds sont necessaires.");
+    }
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        if (!(nodes[i] > nodes[i - 1])) {
+            throw std::invalid_argument("Erreur Grille: Noeuds non strictement croissants.");
+        }
+    }
+
+    LogGrid g;
+    g.type = GridType::Custom;
+    g.x = nodes;
+    return g;
+}
+
+size_t LogGrid::locate(double target_x, size_t lo, size_t hi) const {
+    size_t i = 0;
+
+    switch (type) {
+        case GridType::Uniform: {
+            // Accès direct, sans recherche
+            double pos = std::floor((target_x - x_min) / step);
+            if (!(pos >= static_cast<double>(lo))) return lo; // inclut NaN
+            if (pos >= static_cast<double>(hi)) return hi;
+            i = static_cast<size_t>(pos);
+            break;
+        }
+        case GridType::Sinh: {
+            // Inversion analytique de l'étirement, puis correction d'arrondi d'un noeud
+            double pos = std::floor((std::asinh((target_x - center) / alpha) - c1) / step);
+            if (!(pos >= static_cast<double>(lo))) return lo;
+            if (pos >= static_cast<double>(hi)) return hi;
+            i = static_cast<size_t>(pos);
+            if (i > lo && x[i] > target_x) --i;
+            else if (i < hi && x[i + 1] <= target_x) ++i;
+            break;
+        }
+        case GridType::Custom: {
+            auto it = std::upper_bound(x.begin(), x.end(), target_x);
+            i = (it == x.begin()) ? 0 : static_cast<size_t>(it - x.begin()) - 1;
+            break;
+        }
+    }
+    return std::min(std::max(i, lo), hi);
+}
+
+} // namespace edp
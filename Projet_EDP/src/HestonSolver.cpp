@@ -0,0 +1,397 @@
+#include "edp/HestonSolver.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace edp {
+
+namespace {
+
+    // Colonnes par bloc pour les lignes en v : Nv * 64 doubles restent dans le cache L2
+    constexpr size_t kBlockWidth = 64;
+
+    // Poids de Lagrange cubiques (valeur, dérivées première et seconde) en t, noeuds 0..3
+    void cubicWeights(double t, double* w0, double* w1, double* w2) {
+        for (size_t j = 0; j < 4; ++j) {
+            double denom = 1.0, f0 = 1.0, f1 = 0.0, f2 = 0.0;
+            for (size_t m = 0; m < 4; ++m) {
+                if (m == j) continue;
+                denom *= static_cast<double>(j) - static_cast<double>(m);
+                f0 *= t - static_cast<double>(m);
+                double p1 = 1.0;
+                for (size_t l = 0; l < 4; ++l) {
+                    if (l == j || l == m) continue;
+                    p1 *= t - static_cast<double>(l);
+                    double p2 = 1.0;
+                    for (size_t q = 0; q < 4; ++q) {
+                        if (q == j || q == m || q == l) continue;
+                        p2 *= t - static_cast<double>(q);
+                    }
+                    f2 += p2;
+                }
+                f1 += p1;
+            }
+            w0[j] = f0 / denom;
+            w1[j] = f1 / denom;
+            w2[j] = f2 / denom;
+        }
+    }
+
+    // Premier noeud des 4 noeuds d'interpolation autour de pos (en pas de grille)
+    size_t stencilStart(double pos, size_t n) {
+        double start = std::floor(pos) - 1.0;
+        if (!(start >= 0.0)) return 0;
+        return std::min(static_cast<size_t>(start), n - 4);
+    }
+
+} // namespace
+
+HestonADISolver::HestonADISolver(double T_, double r_, const HestonParameters& model_,
+                                 double S_max_, double v_max_, size_t Nx_, size_t Nv_, size_t M_)
+    : T(T_), r(r_), model(model_), S_max(S_max_), v_max(v_max_), Nx(Nx_), Nv(Nv_), M(M_) {
+    if (!(T > 0.0) || M == 0) {
+        throw std::invalid_argument("Erreur Heston: Maturite ou nombre de pas invalide.");
+    }
+    if (Nx < 6 || Nv < 6 || !(S_max > 0.0) || !(v_max > 0.0)) {
+        throw std::invalid_argument("Erreur Heston: Grille invalide (6 noeuds minimum par direction).");
+    }
+    if (model.kappa < 0.0 || model.theta < 0.0 || model.xi < 0.0 || std::fabs(model.rho) > 1.0) {
+        throw std::invalid_argument("Erreur Heston: Parametres du modele invalides.");
+    }
+
+    // Même domaine en spot que PDESolver
+    double x_min = std::log(S_max / 3000.0);
+    double x_max = std::log(S_max);
+    dx = (x_max - x_min) / static_cast<double>(Nx - 1);
+    dv = v_max / static_cast<double>(Nv - 1);
+
+    x.resize(Nx);
+    S.resize(Nx);
+    for (size_t i = 0; i < Nx; ++i) {
+        x[i] = x_min + i * dx;
+        S[i] = std::exp(x[i]);
+    }
+    v.resize(Nv);
+    for (size_t j = 0; j < Nv; ++j) {
+        v[j] = j * dv;
+    }
+
+    buildCoefficients();
+
+    for (auto* w : {&U, &U_prev, &Y, &A0U, &A1U, &A2U, &A0Y}) {
+        w->resize(Nx * Nv);
+    }
+}
+
+HestonADISolver::~HestonADISolver() = default;
+
+void HestonADISolver::setScheme(AdiScheme scheme_, double theta) {
+    if (!(theta >= 0.5 && theta <= 1.0)) {
+        throw std::invalid_argument("Erreur Heston: theta ADI hors de [0.5, 1].");
+    }
+    scheme = scheme_;
+    theta_adi = theta;
+}
+
+void HestonADISolver::setDampingSteps(size_t steps) {
+    damping_steps = steps;
+}
+
+void HestonADISolver::setThreads(unsigned nThreads) {
+    n_threads = nThreads;
+    pool.reset();
+}
+
+ThreadPool& HestonADISolver::threads() {
+    if (!pool) pool = std::make_unique<ThreadPool>(n_threads);
+    return *pool;
+}
+
+// Coefficients par unité de temps. Le terme -rV est partagé entre A1 et A2.
+void HestonADISolver::buildCoefficients() {
+    const double kappa = model.kappa, theta = model.theta, xi = model.xi, rho = model.rho;
+    for (auto* c : {&a1_lower, &a1_diag, &a1_upper, &a2_lower, &a2_diag, &a2_upper, &a0_coef}) {
+        c->resize(Nv);
+    }
+
+    for (size_t j = 0; j < Nv; ++j) {
+        double vj = v[j];
+
+        // A1 : 0.5 v V_xx + (r - 0.5 v) V_x - 0.5 r V
+        double diff_x = 0.5 * vj / (dx * dx);
+        double conv_x = (r - 0.5 * vj) / (2.0 * dx);
+        a1_lower[j] = diff_x - conv_x;
+        a1_diag[j]  = -2.0 * diff_x - 0.5 * r;
+        a1_upper[j] = diff_x + conv_x;
+
+        // A2 : 0.5 xi^2 v V_vv + kappa (theta - v) V_v - 0.5 r V
+        double diff_v = 0.5 * xi * xi * vj / (dv * dv);
+        double conv_v = kappa * (theta - vj) / (2.0 * dv);
+        if (j == 0) {
+            // v = 0 : seule la dérive kappa*theta subsiste, décentrée vers l'intérieur
+            a2_lower[j] = 0.0;
+            a2_diag[j]  = -kappa * theta / dv - 0.5 * r;
+            a2_upper[j] = kappa * theta / dv;
+        } else if (j == Nv - 1) {
+            // v = v_max : dV/dv = 0 (noeud fantôme symétrique)
+            a2_lower[j] = 2.0 * diff_v;
+            a2_diag[j]  = -2.0 * diff_v - 0.5 * r;
+            a2_upper[j] = 0.0;
+        } else {
+            a2_lower[j] = diff_v - conv_v;
+            a2_diag[j]  = -2.0 * diff_v - 0.5 * r;
+            a2_upper[j] = diff_v + conv_v;
+        }
+
+        // A0 : rho xi v V_xv, nul sur les bords en v
+        a0_coef[j] = (j == 0 || j == Nv - 1) ? 0.0 : rho * xi * vj / (4.0 * dx * dv);
+    }
+}
+
+// Factorisations de I - theta * step * A1 (par ligne, bornes de Dirichlet en identité)
+// et de I - theta * step * A2. Deux jeux conservés : pas amorti et pas courant.
+const HestonADISolver::LineFactors& HestonADISolver::lineFactors(double step, double theta) {
+    for (size_t k = 0; k < 2; ++k) {
+        if (factors[k].step == step && factors[k].theta == theta) {
+            last_factors = k;
+            return factors[k];
+        }
+    }
+    // Remplace le jeu le moins récemment utilisé
+    last_factors = 1 - last_factors;
+    LineFactors& f = factors[last_factors];
+
+    std::vector<double> a(Nx, 0.0), b(Nx, 1.0), c(Nx, 0.0);
+    f.x_lines.resize(Nv);
+    for (size_t j = 0; j < Nv; ++j) {
+        for (size_t i = 1; i + 1 < Nx; ++i) {
+            a[i] = -theta * step * a1_lower[j];
+            b[i] = 1.0 - theta * step * a1_diag[j];
+            c[i] = -theta * step * a1_upper[j];
+        }
+        f.x_lines[j].factorize(a, b, c);
+    }
+
+    std::vector<double> av(Nv), bv(Nv), cv(Nv);
+    for (size_t j = 0; j < Nv; ++j) {
+        av[j] = -theta * step * a2_lower[j];
+        bv[j] = 1.0 - theta * step * a2_diag[j];
+        cv[j] = -theta * step * a2_upper[j];
+    }
+    f.v_lines.factorize(av, bv, cv);
+
+    f.step = step;
+    f.theta = theta;
+    ++factorizations;
+    return f;
+}
+
+// out0 = A0 W, out1 = A1 W, out2 = A2 W (nullptr : non calculé), nuls aux bornes en S.
+// Sur les bords en v, les voisins absents sont remplacés par la ligne elle-même :
+// leurs coefficients y sont nuls, la boucle interne reste sans branchement.
+void HestonADISolver::applyOperators(const std::vector<double>& W, std::vector<double>* out0,
+                                     std::vector<double>* out1, std::vector<double>* out2) {
+    threads().parallelFor(Nv, 4, [&](size_t j_begin, size_t j_end) {
+        for (size_t j = j_begin; j < j_end; ++j) {
+            const double* w  = &W[j * Nx];
+            const double* wm = (j > 0) ? w - Nx : w;
+            const double* wp = (j + 1 < Nv) ? w + Nx : w;
+
+            if (out0) {
+                double* o = &(*out0)[j * Nx];
+                const double k = a0_coef[j];
+                o[0] = o[Nx - 1] = 0.0;
+                for (size_t i = 1; i + 1 < Nx; ++i) {
+                    o[i] = k * (wp[i + 1] - wp[i - 1] - wm[i + 1] + wm[i - 1]);
+                }
+            }
+            if (out1) {
+                double* o = &(*out1)[j * Nx];
+                const double l = a1_lower[j], d = a1_diag[j], u = a1_upper[j];
+                o[0] = o[Nx - 1] = 0.0;
+                for (size_t i = 1; i + 1 < Nx; ++i) {
+                    o[i] = l * w[i - 1] + d * w[i] + u * w[i + 1];
+                }
+            }
+            if (out2) {
+                double* o = &(*out2)[j * Nx];
+                const double l = a2_lower[j], d = a2_diag[j], u = a2_upper[j];
+                o[0] = o[Nx - 1] = 0.0;
+                for (size_t i = 1; i + 1 < Nx; ++i) {
+                    o[i] = l * wm[i] + d * w[i] + u * wp[i];
+                }
+            }
+        }
+    });
+}
+
+// (I - theta step A1) Y = Y - theta step A1U, ligne par ligne (lignes contiguës)
+void HestonADISolver::solveXLines(const LineFactors& f, double step, double theta,
+                                  double V_low, double V_high) {
+    const size_t grain = 4;
+    line_buffers.resize((Nv + grain - 1) / grain);
+    const double ts = theta * step;
+
+    threads().parallelFor(Nv, grain, [&](size_t j_begin, size_t j_end) {
+        std::vector<double>& d = line_buffers[j_begin / grain];
+        d.resize(Nx);
+        for (size_t j = j_begin; j < j_end; ++j) {
+            double* y = &Y[j * Nx];
+            const double* a1u = &A1U[j * Nx];
+            for (size_t i = 0; i < Nx; ++i) d[i] = y[i] - ts * a1u[i];
+            d[0] = V_low;
+            d[Nx - 1] = V_high;
+            f.x_lines[j].apply(d, d);
+            std::copy(d.begin(), d.end(), y);
+        }
+    });
+}
+
+// (I - theta step A2) Y = Y - theta step A2U, par blocs de colonnes : toutes les lignes en v
+// d'un bloc sont résolues ensemble (seconds membres entrelacés, même matrice)
+void HestonADISolver::solveVLines(const LineFactors& f, double step, double theta,
+                                  double V_low, double V_high) {
+    const size_t blocks = (Nx + kBlockWidth - 1) / kBlockWidth;
+    block_buffers.resize(blocks);
+    const double ts = theta * step;
+
+    threads().parallelFor(blocks, 1, [&](size_t b_begin, size_t b_end) {
+        for (size_t blk = b_begin; blk < b_end; ++blk) {
+            const size_t i0 = blk * kBlockWidth;
+            const size_t w = std::min(kBlockWidth, Nx - i0);
+            std::vector<double>& buf = block_buffers[blk];
+            buf.resize(Nv * w);
+
+            for (size_t j = 0; j < Nv; ++j) {
+                const double* y = &Y[j * Nx + i0];
+                const double* a2u = &A2U[j * Nx + i0];
+                double* out = &buf[j * w];
+                for (size_t k = 0; k < w; ++k) out[k] = y[k] - ts * a2u[k];
+            }
+            f.v_lines.applyInterleaved(buf, buf, w);
+            for (size_t j = 0; j < Nv; ++j) {
+                std::copy(buf.begin() + j * w, buf.begin() + (j + 1) * w, Y.begin() + j * Nx + i0);
+            }
+        }
+    });
+
+    for (size_t j = 0; j < Nv; ++j) {
+        Y[j * Nx] = V_low;
+        Y[j * Nx + Nx - 1] = V_high;
+    }
+}
+
+// Un pas ADI de U (temps tau) vers Y (temps tau + step), puis U <- Y
+//   Douglas     : Y0 = U + step (A0 + A1 + A2) U
+//                 (I - theta step A_k) Y_k = Y_{k-1} - theta step A_k U, k = 1, 2
+//   Craig-Sneyd : Y0' = Y0 + step/2 (A0 Y2 - A0 U), puis les deux mêmes corrections
+void HestonADISolver::adiStep(double step, double theta, AdiScheme kind, double V_low, double V_high) {
+    const LineFactors& f = lineFactors(step, theta);
+    applyOperators(U, &A0U, &A1U, &A2U);
+
+    auto predictor = [&](bool craig_sneyd) {
+        threads().parallelFor(Nv, 4, [&](size_t j_begin, size_t j_end) {
+            for (size_t idx = j_begin * Nx; idx < j_end * Nx; ++idx) {
+                double y = U[idx] + step * (A0U[idx] + A1U[idx] + A2U[idx]);
+                if (craig_sneyd) y += 0.5 * step * (A0Y[idx] - A0U[idx]);
+                Y[idx] = y;
+            }
+        });
+    };
+
+    predictor(false);
+    solveXLines(f, step, theta, V_low, V_high);
+    solveVLines(f, step, theta, V_low, V_high);
+
+    if (kind == AdiScheme::CraigSneyd) {
+        applyOperators(Y, &A0Y, nullptr, nullptr);
+        predictor(true);
+        solveXLines(f, step, theta, V_low, V_high);
+        solveVLines(f, step, theta, V_low, V_high);
+    }
+    U.swap(Y);
+}
+
+PricingResults HestonADISolver::solve(const Payoff& payoff, double S0, double v0) {
+    if (!(S0 > S.front() && S0 < S.back()) || !(v0 >= 0.0 && v0 <= v_max)) {
+        throw std::invalid_argument("Erreur Heston: Point (S0, v0) hors de la grille.");
+    }
+
+    // Condition terminale, identique pour toutes les variances
+    payoff.evaluate(S, payoff_row);
+    for (size_t j = 0; j < Nv; ++j) {
+        std::copy(payoff_row.begin(), payoff_row.end(), U.begin() + j * Nx);
+    }
+
+    // Dirichlet en S : même approximation que PDESolver::boundaryValues
+    const double payoff_low = payoff(S.front());
+    const double payoff_high = payoff(S.back());
+    auto boundary = [&](double tau, double& V_low, double& V_high) {
+        double discount = std::exp(-r * tau);
+        V_low = payoff_low * discount;
+        double S_high = S.back();
+        V_high = (payoff_high > S_high * 0.1) ? S_high - (S_high - payoff_high) * discount
+                                              : payoff_high * discount;
+    };
+
+    const double dt = T / static_cast<double>(M);
+    double V_low, V_high;
+    for (size_t n = 0; n < M; ++n) {
+        if (n + 1 == M) U_prev = U;
+        double tau = n * dt;
+
+        if (n < damping_steps) {
+            // Deux demi-pas de Douglas implicite : amortit les modes du payoff
+            boundary(tau + 0.5 * dt, V_low, V_high);
+            adiStep(0.5 * dt, 1.0, AdiScheme::Douglas, V_low, V_high);
+            boundary(tau + dt, V_low, V_high);
+            adiStep(0.5 * dt, 1.0, AdiScheme::Douglas, V_low, V_high);
+        } else {
+            boundary(tau + dt, V_low, V_high);
+            adiStep(dt, theta_adi, scheme, V_low, V_high);
+        }
+    }
+
+    // Interpolation tensorielle de Lagrange cubique en (x, v)
+    double px = (std::log(S0) - x.front()) / dx;
+    double pv = v0 / dv;
+    size_t i0 = stencilStart(px, Nx);
+    size_t j0 = stencilStart(pv, Nv);
+    double wx0[4], wx1[4], wx2[4], wv0[4], wv1[4], wv2[4];
+    cubicWeights(px - static_cast<double>(i0), wx0, wx1, wx2);
+    cubicWeights(pv - static_cast<double>(j0), wv0, wv1, wv2);
+
+    double value = 0.0, V_x = 0.0, V_xx = 0.0, V_v = 0.0, V_tau = 0.0;
+    for (size_t jj = 0; jj < 4; ++jj) {
+        const double* u = &U[(j0 + jj) * Nx + i0];
+        const double* up = &U_prev[(j0 + jj) * Nx + i0];
+        double row0 = 0.0, row1 = 0.0, row2 = 0.0, row_tau = 0.0;
+        for (size_t ii = 0; ii < 4; ++ii) {
+            row0 += wx0[ii] * u[ii];
+            row1 += wx1[ii] * u[ii];
+            row2 += wx2[ii] * u[ii];
+            row_tau += wx0[ii] * (u[ii] - up[ii]);
+        }
+        value += wv0[jj] * row0;
+        V_x   += wv0[jj] * row1;
+        V_xx  += wv0[jj] * row2;
+        V_v   += wv1[jj] * row0;
+        V_tau += wv0[jj] * row_tau;
+    }
+    V_x /= dx;
+    V_xx /= dx * dx;
+    V_v /= dv;
+    V_tau /= dt;
+
+    PricingResults res;
+    res.price = value;
+    res.delta = V_x / S0;
+    res.gamma = (V_xx - V_x) / (S0 * S0);
+    res.theta = -V_tau;
+    res.vega  = 2.0 * std::sqrt(v0) * V_v;
+    res.rho   = std::numeric_limits<double>::quiet_NaN(); // Pas de sensibilité au taux
+    return res;
+}
+
+} // namespace edp
@@ -0,0 +1,149 @@
+#include "edp/ImpliedVol.h"
+#include "edp/BlackScholes.h"
+#include "edp/Payoff.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace edp {
+
+namespace {
+
+    // Cotations dont le biais de discrétisation varie continûment avec le strike
+    auto surfaceKey(const Contract& c, const GridChoice& g) {
+        return std::make_tuple(g.S_max, g.S_min, g.N, g.M, g.rannacher_steps, c.T, c.r, c.theta, c.is_call);
+    }
+
+    // Prix et Vega PDE du contrat à la volatilité sigma (solveur réinitialisé, grille conservée)
+    PricingResults pricePDE(PDESolver& solver, const Contract& c, const GridChoice& g, double sigma) {
+        solver.reset(c.T, c.r, sigma, g.S_max, c.theta, g.N, g.M, g.S_min);
+        solver.setRannacherSteps(g.rannacher_steps);
+        if (c.is_call) {
+            return solver.solve(PayoffCall(c.K), c.S0);
+        }
+        return solver.solve(PayoffPut(c.K), c.S0);
+    }
+
+} // namespace
+
+ImpliedVolSolver::ImpliedVolSolver(unsigned nThreads, const ImpliedVolOptions& opts)
+    : pool(nThreads), options(opts) {}
+
+std::vector<ImpliedVolResult> ImpliedVolSolver::solve(const std::vector<Contract>& quotes,
+                                                      const std::vector<double>& prices) {
+    std::vector<ImpliedVolResult> out;
+    solve(quotes, prices, out);
+    return out;
+}
+
+void ImpliedVolSolver::solve(const std::vector<Contract>& quotes, const std::vector<double>& prices,
+                             std::vector<ImpliedVolResult>& out) {
+    const size_t n = quotes.size();
+    if (prices.size() != n) {
+        throw std::invalid_argument("Erreur ImpliedVol: Un prix par cotation est attendu.");
+    }
+    for (const Contract& c : quotes) {
+        if (!(c.S0 > 0.0) || !(c.K > 0.0) || !(c.T > 0.0)) {
+            throw std::invalid_argument("Erreur ImpliedVol: S0, K et T doivent etre positifs.");
+        }
+    }
+
+    // Inversion de Black-Scholes (départ des itérations), puis grille de chaque cotation :
+    // une grille automatique est dimensionnée à cette volatilité, et fixe pour toutes les itérations
+    std::vector<double> sigma_bs(n);
+    std::vector<GridChoice> grids(n);
+    for (size_t q = 0; q < n; ++q) {
+        Contract c = quotes[q];
+        sigma_bs[q] = blackScholesImpliedVol(c.is_call, prices[q], c.S0, c.K, c.T, c.r);
+        const bool automatic = (c.domain_std > 0.0 || c.tolerance > 0.0);
+        if (automatic && !std::isfinite(sigma_bs[q])) continue; // Hors des bornes : pas de volatilité de dimensionnement
+        c.sigma = sigma_bs[q];
+        grids[q] = gridFor(c);
+        if (!(c.S0 < grids[q].S_max)) {
+            throw std::invalid_argument("Erreur ImpliedVol: S0 hors de la grille (S0 >= S_max).");
+        }
+    }
+    out.assign(n, ImpliedVolResult());
+    solves = 0;
+    if (n == 0) return;
+
+    // Tri par grille, maturité, type puis strike : reset() ne reconstruit pas la grille,
+    // et chaque cotation suit sa voisine de strike (départ à chaud)
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::tuple_cat(surfaceKey(quotes[a], grids[a]), std::make_tuple(quotes[a].K))
+             < std::tuple_cat(surfaceKey(quotes[b], grids[b]), std::make_tuple(quotes[b].K));
+    });
+
+    std::atomic<size_t> total_solves{0};
+    const size_t grain = std::max<size_t>(1, n / (8 * pool.size()));
+    pool.parallelFor(n, grain, [&](size_t begin, size_t end) {
+        std::unique_ptr<PDESolver> solver;
+        size_t local_solves = 0;
+        double prev_bias = 0.0;
+
+        for (size_t j = begin; j < end; ++j) {
+            const size_t q = order[j];
+            const Contract& c = quotes[q];
+            ImpliedVolResult& res = out[q];
+
+            const GridChoice& g = grids[q];
+            if (!std::isfinite(sigma_bs[q])) continue; // Hors des bornes de non-arbitrage
+
+            // Départ à chaud : biais PDE - BS de la cotation précédente de même grille
+            // et maturité (strike voisin après tri), sinon inversion BS seule
+            double sigma = sigma_bs[q];
+            const size_t prev = (j > begin) ? order[j - 1] : q;
+            if (j > begin && out[prev].converged
+                && surfaceKey(quotes[prev], grids[prev]) == surfaceKey(c, g)) {
+                double guess = sigma_bs[q] + prev_bias;
+                if (guess > 0.0) sigma = guess;
+            }
+
+            if (!solver) {
+                // Opérateur propre au solveur (une volatilité par itération : rien à partager),
+                // grille lue dans le cache
+                solver = std::make_unique<PDESolver>(c.T, c.r, sigma, g.S_max, c.theta, g.N, g.M);
+                solver->setShareOperators(false);
+                solver->setComputeSensitivities(true);
+            }
+
+            while (res.solves < options.max_solves) {
+                PricingResults pde = pricePDE(*solver, c, g, sigma);
+                ++res.solves;
+                res.model_price = pde.price;
+
+                double residual = pde.price - prices[q];
+                if (!(pde.vega > 0.0)) break;
+                double step = residual / pde.vega;
+                if (options.halley) {
+                    // f''/f' approché par la courbure de Black-Scholes : d1 d2 / sigma
+                    double vol_sqrtT = sigma * std::sqrt(c.T);
+                    double d1 = (std::log(c.S0 / c.K) + (c.r + 0.5 * sigma * sigma) * c.T) / vol_sqrtT;
+                    double d2 = d1 - vol_sqrtT;
+                    double denom = 1.0 - 0.5 * step * d1 * d2 / sigma;
+                    if (denom > 0.5 && denom < 2.0) step /= denom;
+                }
+                double next = std::max(sigma - step, 0.5 * sigma);
+                bool done = std::fabs(next - sigma) < options.tolerance;
+                sigma = next;
+                if (done) {
+                    res.converged = true;
+                    break;
+                }
+            }
+            res.sigma = sigma;
+            local_solves += res.solves;
+            prev_bias = sigma - sigma_bs[q];
+        }
+        total_solves += local_solves;
+    });
+    solves = total_solves.load();
+}
+
+} // namespace edp
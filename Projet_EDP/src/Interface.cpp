@@ -1,9 +1,40 @@
 #include "edp/Interface.h"
 #include <iostream>
+#include <stdexcept>
 
 namespace edp {
 
+bool Interface::parseCommandLine(int argc, char* argv[]) {
+    if (argc < 2) {
+        return false;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--batch" && hasValue) {
+            batchInput = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            batchOutput = argv[++i];
+        } else if (arg == "--threads" && hasValue) {
+            batchThreads = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (arg == "--stats" && hasValue) {
+            batchStats = argv[++i];
+        } else if (arg == "--sensitivities") {
+            batchSensitivities = true;
+        } else {
+            throw std::invalid_argument("Erreur Interface: Argument inconnu ou incomplet '" + arg +
+                                        "' (usage : --batch <fichier> [--output <fichier>] [--threads <n>] [--stats <fichier>] [--sensitivities]).");
+        }
+    }
 
+    if (batchInput.empty()) {
+        throw std::invalid_argument("Erreur Interface: --batch <fichier> est requis.");
+    }
+    runMode = RunMode::Batch;
+    return true;
+}
 
 void Interface::askRunMode() {
     std::cout << "==========================================" << std::endl;
@@ -57,17 +88,24 @@ void Interface::askParameters() {
     std::cout << "\n--- Parametres du Moteur EDP ---" << std::endl;
 
     double defaultSmax = K * 4.0;
-    std::cout << "[7] S_max (Borne haute, suggestion: " << defaultSmax << ") : ";
+    std::cout << "[7] S_max (Borne haute, suggestion: " << defaultSmax << " ; 0 = domaine automatique) : ";
     std::cin >> S_max;
 
-    std::cout << "[8] Nombre de pas de temps (M) : ";
-    std::cin >> M;
+    std::cout << "[8] Precision cible sur le prix (0 = choisir M et N) : ";
+    std::cin >> tolerance;
+
+    if (tolerance <= 0.0) {
+        tolerance = 0.0;
 
-    std::cout << "[9] Nombre de pas d'espace (N) : ";
-    std::cin >> N;
+        std::cout << "[9] Nombre de pas de temps (M) : ";
+        std::cin >> M;
+
+        std::cout << "[10] Nombre de pas d'espace (N) : ";
+        std::cin >> N;
+    }
     
     
-    std::cout << "[10] Theta (0.5 = Crank-Nicolson, 1.0 = Implicite) : ";
+    std::cout << "[11] Theta (0.5 = Crank-Nicolson, 1.0 = Implicite) : ";
     std::cin >> theta_scheme;
 
     std::cout << "\n==========================================" << std::endl;
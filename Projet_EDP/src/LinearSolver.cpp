@@ -2,14 +2,177 @@
 #include <stdexcept> 
 #include <cmath>     
 #include <string>    
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define EDP_HAS_X86_SIMD 1
+#include <immintrin.h>
+#endif
 
 namespace edp { 
 
-    void thomasAlgorithm(const std::vector<double>& a,
-                         const std::vector<double>& b,
-                         const std::vector<double>& c,
-                         const std::vector<double>& d,
-                         std::vector<double>& x) {
+namespace {
+
+    // Seuil de pivot commun à toutes les variantes
+    constexpr double kPivotTolerance = 1e-15;
+
+    // --- Noyau scalaire entrelacé, voies [k_begin, k_end) ---
+    // Renvoie l'indice de la ligne au pivot nul, ou n si tout s'est bien passé.
+    // x reçoit d' pendant la descente, cp reçoit c'.
+    size_t batchScalar(const double* a, const double* b, const double* c, const double* d,
+                       double* x, double* cp, size_t n, size_t K,
+                       size_t k_begin, size_t k_end) {
+        for (size_t k = k_begin; k < k_end; ++k) {
+            double pivot = b[k];
+            if (std::abs(pivot) < kPivotTolerance) return 0;
+            cp[k] = c[k] / pivot;
+            x[k]  = d[k] / pivot;
+        }
+        for (size_t i = 1; i < n; ++i) {
+            const size_t row = i * K, prev = row - K;
+            for (size_t k = k_begin; k < k_end; ++k) {
+                double denominator = b[row + k] - a[row + k] * cp[prev + k];
+                if (std::abs(denominator) < kPivotTolerance) return i;
+                double temp = 1.0 / denominator;
+                cp[row + k] = (i < n - 1) ? c[row + k] * temp : c[row + k];
+                x[row + k]  = (d[row + k] - a[row + k] * x[prev + k]) * temp;
+            }
+        }
+        for (size_t i = n - 2; i != static_cast<size_t>(-1); --i) {
+            const size_t row = i * K, next = row + K;
+            for (size_t k = k_begin; k < k_end; ++k) {
+                x[row + k] = x[row + k] - cp[row + k] * x[next + k];
+            }
+        }
+        return n;
+    }
+
+#ifdef EDP_HAS_X86_SIMD
+
+    // --- Noyau AVX2 : 4 systèmes par registre, voies [0, k_end) avec k_end multiple de 4 ---
+    __attribute__((target("avx2")))
+    size_t batchAVX2(const double* a, const double* b, const double* c, const double* d,
+                     double* x, double* cp, size_t n, size_t K, size_t k_end) {
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d tol = _mm256_set1_pd(kPivotTolerance);
+        const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+
+        for (size_t k = 0; k < k_end; k += 4) {
+            __m256d pivot = _mm256_loadu_pd(b + k);
+            __m256d bad = _mm256_cmp_pd(_mm256_and_pd(pivot, abs_mask), tol, _CMP_LT_OQ);
+            if (_mm256_movemask_pd(bad)) return 0;
+            _mm256_storeu_pd(cp + k, _mm256_div_pd(_mm256_loadu_pd(c + k), pivot));
+            _mm256_storeu_pd(x + k,  _mm256_div_pd(_mm256_loadu_pd(d + k), pivot));
+        }
+        for (size_t i = 1; i < n; ++i) {
+            const size_t row = i * K, prev = row - K;
+            const bool last = (i == n - 1);
+            for (size_t k = 0; k < k_end; k += 4) {
+                __m256d ai = _mm256_loadu_pd(a + row + k);
+                __m256d den = _mm256_sub_pd(_mm256_loadu_pd(b + row + k),
+                                            _mm256_mul_pd(ai, _mm256_loadu_pd(cp + prev + k)));
+                __m256d bad = _mm256_cmp_pd(_mm256_and_pd(den, abs_mask), tol, _CMP_LT_OQ);
+                if (_mm256_movemask_pd(bad)) return i;
+                __m256d temp = _mm256_div_pd(one, den);
+                __m256d ci = _mm256_loadu_pd(c + row + k);
+                _mm256_storeu_pd(cp + row + k, last ? ci : _mm256_mul_pd(ci, temp));
+                __m256d num = _mm256_sub_pd(_mm256_loadu_pd(d + row + k),
+                                            _mm256_mul_pd(ai, _mm256_loadu_pd(x + prev + k)));
+                _mm256_storeu_pd(x + row + k, _mm256_mul_pd(num, temp));
+            }
+        }
+        for (size_t i = n - 2; i != static_cast<size_t>(-1); --i) {
+            const size_t row = i * K, next = row + K;
+            for (size_t k = 0; k < k_end; k += 4) {
+                __m256d xi = _mm256_sub_pd(_mm256_loadu_pd(x + row + k),
+                                           _mm256_mul_pd(_mm256_loadu_pd(cp + row + k),
+                                                         _mm256_loadu_pd(x + next + k)));
+                _mm256_storeu_pd(x + row + k, xi);
+            }
+        }
+        return n;
+    }
+
+    // --- Noyau AVX-512 : 8 systèmes par registre, voies [0, k_end) avec k_end multiple de 8 ---
+    __attribute__((target("avx512f")))
+    size_t batchAVX512(const double* a, const double* b, const double* c, const double* d,
+                       double* x, double* cp, size_t n, size_t K, size_t k_end) {
+        const __m512d one = _mm512_set1_pd(1.0);
+        const __m512d tol = _mm512_set1_pd(kPivotTolerance);
+
+        for (size_t k = 0; k < k_end; k += 8) {
+            __m512d pivot = _mm512_loadu_pd(b + k);
+            if (_mm512_cmp_pd_mask(_mm512_abs_pd(pivot), tol, _CMP_LT_OQ)) return 0;
+            _mm512_storeu_pd(cp + k, _mm512_div_pd(_mm512_loadu_pd(c + k), pivot));
+            _mm512_storeu_pd(x + k,  _mm512_div_pd(_mm512_loadu_pd(d + k), pivot));
+        }
+        for (size_t i = 1; i < n; ++i) {
+            const size_t row = i * K, prev = row - K;
+            const bool last = (i == n - 1);
+            for (size_t k = 0; k < k_end; k += 8) {
+                __m512d ai = _mm512_loadu_pd(a + row + k);
+                __m512d den = _mm512_sub_pd(_mm512_loadu_pd(b + row + k),
+                                            _mm512_mul_pd(ai, _mm512_loadu_pd(cp + prev + k)));
+                if (_mm512_cmp_pd_mask(_mm512_abs_pd(den), tol, _CMP_LT_OQ)) return i;
+                __m512d temp = _mm512_div_pd(one, den);
+                __m512d ci = _mm512_loadu_pd(c + row + k);
+                _mm512_storeu_pd(cp + row + k, last ? ci : _mm512_mul_pd(ci, temp));
+                __m512d num = _mm512_sub_pd(_mm512_loadu_pd(d + row + k),
+                                            _mm512_mul_pd(ai, _mm512_loadu_pd(x + prev + k)));
+                _mm512_storeu_pd(x + row + k, _mm512_mul_pd(num, temp));
+            }
+        }
+        for (size_t i = n - 2; i != static_cast<size_t>(-1); --i) {
+            const size_t row = i * K, next = row + K;
+            for (size_t k = 0; k < k_end; k += 8) {
+                __m512d xi = _mm512_sub_pd(_mm512_loadu_pd(x + row + k),
+                                           _mm512_mul_pd(_mm512_loadu_pd(cp + row + k),
+                                                         _mm512_loadu_pd(x + next + k)));
+                _mm512_storeu_pd(x + row + k, xi);
+            }
+        }
+        return n;
+    }
+
+#endif // EDP_HAS_X86_SIMD
+
+    // Taille minimale d'un bloc du solveur partitionné
+    constexpr size_t kMinPartitionBlock = 64;
+
+} // namespace
+
+    SimdLevel detectSimdLevel() {
+#ifdef EDP_HAS_X86_SIMD
+        static const SimdLevel level = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+            if (__builtin_cpu_supports("avx2"))    return SimdLevel::AVX2;
+            return SimdLevel::Scalar;
+        }();
+        return level;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+
+    template <typename Real>
+    void thomasAlgorithm(const std::vector<Real>& a,
+                         const std::vector<Real>& b,
+                         const std::vector<Real>& c,
+                         const std::vector<Real>& d,
+                         std::vector<Real>& x) {
+        BasicThomasWorkspace<Real> ws;
+        thomasAlgorithm(a, b, c, d, x, ws);
+    }
+
+    template <typename Real>
+    void thomasAlgorithm(const std::vector<Real>& a,
+                         const std::vector<Real>& b,
+                         const std::vector<Real>& c,
+                         const std::vector<Real>& d,
+                         std::vector<Real>& x,
+                         BasicThomasWorkspace<Real>& ws) {
         
         size_t n = d.size();
 
@@ -27,12 +190,14 @@ namespace edp {
             x.resize(n);
         }
 
-        // Copies de travail
-        std::vector<double> c_prime = c; // Copie car modifié
-        std::vector<double> d_prime = d; // Copie car modifié
+        // Copies de travail (assign réutilise la capacité déjà allouée)
+        std::vector<Real>& c_prime = ws.c_prime;
+        std::vector<Real>& d_prime = ws.d_prime;
+        c_prime.assign(c.begin(), c.end()); // Copie car modifié
+        d_prime.assign(d.begin(), d.end()); // Copie car modifié
 
         // --- ÉTAPE 1 : DESCENTE ---
-        double pivot = b[0];
+        Real pivot = b[0];
         
         if (std::abs(pivot) < 1e-15) {
              throw std::runtime_error("Erreur Solver: Pivot nul a l'indice 0.");
@@ -42,13 +207,13 @@ namespace edp {
         d_prime[0] /= pivot;
 
         for (size_t i = 1; i < n; ++i) {
-            double denominator = b[i] - a[i] * c_prime[i - 1];
+            Real denominator = b[i] - a[i] * c_prime[i - 1];
             
             if (std::abs(denominator) < 1e-15) {
                 throw std::runtime_error("Erreur Solver: Pivot nul a l'indice " + std::to_string(i));
             }
             
-            double temp = 1.0 / denominator;
+            Real temp = Real(1) / denominator;
             
             if (i < n - 1) {
                 c_prime[i] *= temp;
@@ -67,4 +232,511 @@ namespace edp {
         }
     }
 
-} // namespace edp
\ No newline at end of file
+    template void thomasAlgorithm<double>(const std::vector<double>&, const std::vector<double>&,
+                                          const std::vector<double>&, const std::vector<double>&,
+                                          std::vector<double>&);
+    template void thomasAlgorithm<double>(const std::vector<double>&, const std::vector<double>&,
+                                          const std::vector<double>&, const std::vector<double>&,
+                                          std::vector<double>&, ThomasWorkspace&);
+    template void thomasAlgorithm<float>(const std::vector<float>&, const std::vector<float>&,
+                                         const std::vector<float>&, const std::vector<float>&,
+                                         std::vector<float>&);
+    template void thomasAlgorithm<float>(const std::vector<float>&, const std::vector<float>&,
+                                         const std::vector<float>&, const std::vector<float>&,
+                                         std::vector<float>&, BasicThomasWorkspace<float>&);
+
+    template <typename Real>
+    void BasicTridiagonalFactorization<Real>::factorize(const std::vector<Real>& a,
+                                             const std::vector<Real>& b,
+                                             const std::vector<Real>& c) {
+        size_t n = b.size();
+
+        // --- VALIDATION ---
+        if (n == 0) {
+            throw std::invalid_argument("Erreur Solver: Le systeme est vide.");
+        }
+        if (a.size() != n || c.size() != n) {
+            throw std::invalid_argument("Erreur Solver: Dimensions des vecteurs a, b, c incoherentes.");
+        }
+
+        lower = a;
+        c_prime.resize(n);
+        inv_pivot.resize(n);
+
+        // --- ÉLIMINATION (une seule fois, tests de pivot inclus) ---
+        Real pivot = b[0];
+
+        if (std::abs(pivot) < 1e-15) {
+             throw std::runtime_error("Erreur Solver: Pivot nul a l'indice 0.");
+        }
+
+        inv_pivot[0] = Real(1) / pivot;
+        c_prime[0] = c[0] * inv_pivot[0];
+
+        for (size_t i = 1; i < n; ++i) {
+            Real denominator = b[i] - a[i] * c_prime[i - 1];
+
+            if (std::abs(denominator) < 1e-15) {
+                throw std::runtime_error("Erreur Solver: Pivot nul a l'indice " + std::to_string(i));
+            }
+
+            inv_pivot[i] = Real(1) / denominator;
+            c_prime[i] = (i < n - 1) ? c[i] * inv_pivot[i] : Real(0);
+        }
+    }
+
+    template <typename Real>
+    void BasicTridiagonalFactorization<Real>::refactorize(const std::vector<Real>& a,
+                                               const std::vector<Real>& b,
+                                               const std::vector<Real>& c,
+                                               size_t first) {
+        size_t n = inv_pivot.size();
+
+        if (first == 0 || n == 0) {
+            factorize(a, b, c);
+            return;
+        }
+        if (a.size() != n || b.size() != n || c.size() != n) {
+            throw std::invalid_argument("Erreur Solver: Dimensions incoherentes avec la factorisation.");
+        }
+        if (first >= n) {
+            return;
+        }
+
+        // Lignes [0, first) inchangées : l'élimination reprend à la ligne first
+        std::copy(a.begin() + first, a.end(), lower.begin() + first);
+        for (size_t i = first; i < n; ++i) {
+            Real denominator = b[i] - a[i] * c_prime[i - 1];
+
+            if (std::abs(denominator) < 1e-15) {
+                throw std::runtime_error("Erreur Solver: Pivot nul a l'indice " + std::to_string(i));
+            }
+
+            inv_pivot[i] = Real(1) / denominator;
+            c_prime[i] = (i < n - 1) ? c[i] * inv_pivot[i] : Real(0);
+        }
+    }
+
+    template <typename Real>
+    void BasicTridiagonalFactorization<Real>::apply(const std::vector<Real>& d,
+                                         std::vector<Real>& x) const {
+        size_t n = inv_pivot.size();
+
+        if (d.size() != n) {
+            throw std::invalid_argument("Erreur Solver: Second membre de taille incoherente avec la factorisation.");
+        }
+        if (x.size() != n) {
+            x.resize(n);
+        }
+
+        // --- DESCENTE (second membre uniquement) ---
+        // x sert de stockage pour d' : d[i] est lu avant l'écriture de x[i]
+        x[0] = d[0] * inv_pivot[0];
+        for (size_t i = 1; i < n; ++i) {
+            x[i] = (d[i] - lower[i] * x[i - 1]) * inv_pivot[i];
+        }
+
+        // --- REMONTÉE ---
+        for (size_t i = n - 2; i != static_cast<size_t>(-1); --i) {
+            x[i] -= c_prime[i] * x[i + 1];
+        }
+    }
+
+    template <typename Real>
+    void BasicTridiagonalFactorization<Real>::applyInterleaved(const std::vector<Real>& d,
+                                                    std::vector<Real>& x,
+                                                    size_t nrhs) const {
+        size_t n = inv_pivot.size();
+
+        if (nrhs == 0 || d.size() != n * nrhs) {
+            throw std::invalid_argument("Erreur Solver: Seconds membres de taille incoherente avec la factorisation.");
+        }
+        if (x.size() != n * nrhs) {
+            x.resize(n * nrhs);
+        }
+
+        // --- DESCENTE ---
+        for (size_t k = 0; k < nrhs; ++k) {
+            x[k] = d[k] * inv_pivot[0];
+        }
+        for (size_t i = 1; i < n; ++i) {
+            const Real a_i = lower[i];
+            const Real p_i = inv_pivot[i];
+            const Real* d_i = &d[i * nrhs];
+            const Real* x_prev = &x[(i - 1) * nrhs];
+            Real* x_i = &x[i * nrhs];
+            for (size_t k = 0; k < nrhs; ++k) {
+                x_i[k] = (d_i[k] - a_i * x_prev[k]) * p_i;
+            }
+        }
+
+        // --- REMONTÉE ---
+        for (size_t i = n - 2; i != static_cast<size_t>(-1); --i) {
+            const Real c_i = c_prime[i];
+            const Real* x_next = &x[(i + 1) * nrhs];
+            Real* x_i = &x[i * nrhs];
+            for (size_t k = 0; k < nrhs; ++k) {
+                x_i[k] -= c_i * x_next[k];
+            }
+        }
+    }
+
+    template class BasicTridiagonalFactorization<double>;
+    template class BasicTridiagonalFactorization<float>;
+
+    void thomasAlgorithmBatch(const std::vector<double>& a,
+                              const std::vector<double>& b,
+                              const std::vector<double>& c,
+                              const std::vector<double>& d,
+                              std::vector<double>& x,
+                              size_t nsys,
+                              ThomasWorkspace& ws) {
+        thomasAlgorithmBatch(a, b, c, d, x, nsys, ws, detectSimdLevel());
+    }
+
+    void thomasAlgorithmBatch(const std::vector<double>& a,
+                              const std::vector<double>& b,
+                              const std::vector<double>& c,
+                              const std::vector<double>& d,
+                              std::vector<double>& x,
+                              size_t nsys,
+                              ThomasWorkspace& ws,
+                              SimdLevel level) {
+        size_t total = d.size();
+
+        // --- VALIDATION ---
+        if (nsys == 0 || total == 0 || total % nsys != 0) {
+            throw std::invalid_argument("Erreur Solver: Taille du lot incoherente avec le nombre de systemes.");
+        }
+        if (a.size() != total || b.size() != total || c.size() != total) {
+            throw std::invalid_argument("Erreur Solver: Dimensions des vecteurs a, b, c incoherentes.");
+        }
+
+        size_t n = total / nsys;
+        if (x.size() != total) {
+            x.resize(total);
+        }
+        ws.c_prime.resize(total);
+
+        // On ne dépasse jamais ce que le processeur sait exécuter
+        if (static_cast<int>(level) > static_cast<int>(detectSimdLevel())) {
+            level = detectSimdLevel();
+        }
+
+        // Voies [0, k_simd) : noyau vectoriel ; voies restantes : noyau scalaire
+        size_t k_simd = 0;
+        size_t failed_row = n;
+#ifdef EDP_HAS_X86_SIMD
+        if (level == SimdLevel::AVX512) {
+            k_simd = nsys - nsys % 8;
+            if (k_simd > 0) {
+                failed_row = batchAVX512(a.data(), b.data(), c.data(), d.data(),
+                                         x.data(), ws.c_prime.data(), n, nsys, k_simd);
+            }
+        } else if (level == SimdLevel::AVX2) {
+            k_simd = nsys - nsys % 4;
+            if (k_simd > 0) {
+                failed_row = batchAVX2(a.data(), b.data(), c.data(), d.data(),
+                                       x.data(), ws.c_prime.data(), n, nsys, k_simd);
+            }
+        }
+#endif
+        if (failed_row == n && k_simd < nsys) {
+            failed_row = batchScalar(a.data(), b.data(), c.data(), d.data(),
+                                     x.data(), ws.c_prime.data(), n, nsys, k_simd, nsys);
+        }
+
+        if (failed_row != n) {
+            throw std::runtime_error("Erreur Solver: Pivot nul a l'indice " + std::to_string(failed_row));
+        }
+    }
+
+    void PartitionedTridiagonalSolver::factorize(const std::vector<double>& a,
+                                                 const std::vector<double>& b,
+                                                 const std::vector<double>& c,
+                                                 unsigned nThreads) {
+        n = b.size();
+
+        // --- VALIDATION ---
+        if (n == 0) {
+            throw std::invalid_argument("Erreur Solver: Le systeme est vide.");
+        }
+        if (a.size() != n || c.size() != n) {
+            throw std::invalid_argument("Erreur Solver: Dimensions des vecteurs a, b, c incoherentes.");
+        }
+        if (nThreads == 0) {
+            throw std::invalid_argument("Erreur Solver: Nombre de threads nul.");
+        }
+
+        // --- PARTITION : P blocs de lignes internes + (P-1) séparateurs ---
+        size_t P = std::min<size_t>(nThreads, std::max<size_t>(1, (n + 1) / (kMinPartitionBlock + 1)));
+        size_t interior = n - (P - 1);
+        size_t base = interior / P, remainder = interior % P;
+
+        block_begin.resize(P + 1);
+        block_begin[0] = 0;
+        for (size_t p = 0; p < P; ++p) {
+            size_t len = base + (p < remainder ? 1 : 0);
+            block_begin[p + 1] = block_begin[p] + len + 1; // +1 : séparateur qui suit le bloc
+        }
+
+        lower = a;
+        upper = c;
+        c_prime.assign(n, 0.0);
+        inv_pivot.assign(n, 0.0);
+        spike_left.assign(n, 0.0);
+        spike_right.assign(n, 0.0);
+
+        // --- ÉLIMINATION LOCALE ET SPIKES (une fois par matrice) ---
+        for (size_t p = 0; p < P; ++p) {
+            size_t s = block_begin[p], e = block_begin[p + 1] - 1;
+
+            for (size_t i = s; i < e; ++i) {
+                double denominator = (i == s) ? b[i] : b[i] - a[i] * c_prime[i - 1];
+                if (std::abs(denominator) < kPivotTolerance) {
+                    throw std::runtime_error("Erreur Solver: Pivot nul a l'indice " + std::to_string(i));
+                }
+                inv_pivot[i] = 1.0 / denominator;
+                c_prime[i] = (i < e - 1) ? c[i] * inv_pivot[i] : 0.0;
+            }
+
+            // v = T_p^{-1} (-a[s] e_0) : couplage au séparateur de gauche
+            if (p > 0) {
+                spike_left[s] = -a[s] * inv_pivot[s];
+                for (size_t i = s + 1; i < e; ++i) {
+                    spike_left[i] = -a[i] * spike_left[i - 1] * inv_pivot[i];
+                }
+                for (size_t i = e - 1; i-- > s;) {
+                    spike_left[i] -= c_prime[i] * spike_left[i + 1];
+                }
+            }
+
+            // w = T_p^{-1} (-c[e-1] e_last) : couplage au séparateur de droite
+            if (p + 1 < P) {
+                spike_right[e - 1] = -c[e - 1] * inv_pivot[e - 1];
+                for (size_t i = e - 1; i-- > s;) {
+                    spike_right[i] = -c_prime[i] * spike_right[i + 1];
+                }
+            }
+        }
+
+        // --- SYSTÈME RÉDUIT SUR LES SÉPARATEURS ---
+        if (P > 1) {
+            std::vector<double> r_lower(P - 1), r_diag(P - 1), r_upper(P - 1);
+            for (size_t q = 0; q + 1 < P; ++q) {
+                size_t j = block_begin[q + 1] - 1;
+                r_lower[q] = a[j] * spike_left[j - 1];
+                r_diag[q]  = b[j] + a[j] * spike_right[j - 1] + c[j] * spike_left[j + 1];
+                r_upper[q] = c[j] * spike_right[j + 1];
+            }
+            reduced.factorize(r_lower, r_diag, r_upper);
+            z.resize(P - 1);
+
+            // Threads permanents : recréés seulement si le nombre de blocs change
+            if (!pool || pool->size() != P) {
+                pool = std::make_unique<ThreadPool>(static_cast<unsigned>(P));
+            }
+        }
+    }
+
+    // Descente/remontée locale : x = T_p^{-1} d sur les lignes du bloc p
+    void PartitionedTridiagonalSolver::solveBlock(size_t p, const double* d, double* x) const {
+        size_t s = block_begin[p], e = block_begin[p + 1] - 1;
+
+        x[s] = d[s] * inv_pivot[s];
+        for (size_t i = s + 1; i < e; ++i) {
+            x[i] = (d[i] - lower[i] * x[i - 1]) * inv_pivot[i];
+        }
+        for (size_t i = e - 1; i-- > s;) {
+            x[i] -= c_prime[i] * x[i + 1];
+        }
+    }
+
+    // Correction par les séparateurs : x += v * z_gauche + w * z_droite
+    void PartitionedTridiagonalSolver::correctBlock(size_t p, double* x) const {
+        size_t s = block_begin[p], e = block_begin[p + 1] - 1;
+        size_t P = blocks();
+
+        if (p > 0) {
+            const double z_left = z[p - 1];
+            for (size_t i = s; i < e; ++i) x[i] += spike_left[i] * z_left;
+        }
+        if (p + 1 < P) {
+            const double z_right = z[p];
+            for (size_t i = s; i < e; ++i) x[i] += spike_right[i] * z_right;
+        }
+    }
+
+    void PartitionedTridiagonalSolver::apply(const std::vector<double>& d,
+                                             std::vector<double>& x) const {
+        if (d.size() != n || n == 0) {
+            throw std::invalid_argument("Erreur Solver: Second membre de taille incoherente avec la factorisation.");
+        }
+        if (x.size() != n) {
+            x.resize(n);
+        }
+
+        size_t P = blocks();
+        const double* dp = d.data();
+        double* xp = x.data();
+
+        // Un seul bloc : Thomas séquentiel
+        if (P == 1) {
+            solveBlock(0, dp, xp);
+            return;
+        }
+
+        // 1. Solutions locales (parallèle). Les tâches ne capturent que this :
+        // std::function sans allocation, second membre lu dans job_d / job_x.
+        job_d = dp;
+        job_x = xp;
+        pool->parallelFor(P, 1, [this](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p) solveBlock(p, job_d, job_x);
+        });
+
+        // 2. Système réduit (séquentiel, taille P-1)
+        for (size_t q = 0; q + 1 < P; ++q) {
+            size_t j = block_begin[q + 1] - 1;
+            z[q] = dp[j] - lower[j] * xp[j - 1] - upper[j] * xp[j + 1];
+        }
+        reduced.apply(z, z);
+        for (size_t q = 0; q + 1 < P; ++q) {
+            xp[block_begin[q + 1] - 1] = z[q];
+        }
+
+        // 3. Correction des blocs (parallèle)
+        pool->parallelFor(P, 1, [this](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p) correctBlock(p, job_x);
+        });
+    }
+
+    void parallelThomasAlgorithm(const std::vector<double>& a,
+                                 const std::vector<double>& b,
+                                 const std::vector<double>& c,
+                                 const std::vector<double>& d,
+                                 std::vector<double>& x,
+                                 unsigned nThreads) {
+        PartitionedTridiagonalSolver solver;
+        solver.factorize(a, b, c, nThreads);
+        solver.apply(d, x);
+    }
+
+    void brennanSchwartz(const std::vector<double>& a,
+                         const std::vector<double>& b,
+                         const std::vector<double>& c,
+                         const std::vector<double>& d,
+                         const std::vector<double>& g,
+                         std::vector<double>& x,
+                         ThomasWorkspace& ws,
+                         ExerciseSide side) {
+        size_t n = d.size();
+
+        if (n == 0) {
+            throw std::invalid_argument("Erreur Solver: Le systeme est vide.");
+        }
+        if (a.size() != n || b.size() != n || c.size() != n || g.size() != n) {
+            throw std::invalid_argument("Erreur Solver: Dimensions des vecteurs a, b, c, g incoherentes.");
+        }
+        if (x.size() != n) {
+            x.resize(n);
+        }
+
+        // e : coefficient éliminé (c' ou a'), f : second membre éliminé
+        std::vector<double>& e = ws.c_prime;
+        std::vector<double>& f = ws.d_prime;
+        e.resize(n);
+        f.resize(n);
+
+        if (side == ExerciseSide::High) {
+            // Élimination descendante (Thomas), puis remontée projetée depuis le haut
+            double pivot = b[0];
+            if (std::abs(pivot) < kPivotTolerance) {
+                throw std::runtime_error("Erreur Solver: Pivot nul a l'indice 0.");
+            }
+            e[0] = c[0] / pivot;
+            f[0] = d[0] / pivot;
+            for (size_t i = 1; i < n; ++i) {
+                double denominator = b[i] - a[i] * e[i - 1];
+                if (std::abs(denominator) < kPivotTolerance) {
+                    throw std::runtime_error("Erreur Solver: Pivot nul a l'indice " + std::to_string(i));
+                }
+                double temp = 1.0 / denominator;
+                e[i] = c[i] * temp;
+                f[i] = (d[i] - a[i] * f[i - 1]) * temp;
+            }
+
+            x[n - 1] = std::max(g[n - 1], f[n - 1]);
+            for (size_t i = n - 2; i != static_cast<size_t>(-1); --i) {
+                x[i] = std::max(g[i], f[i] - e[i] * x[i + 1]);
+            }
+        } else {
+            // Élimination remontante (depuis le haut, sans exercice),
+            // puis descente projetée depuis le bas (région d'exercice)
+            double pivot = b[n - 1];
+            if (std::abs(pivot) < kPivotTolerance) {
+                throw std::runtime_error("Erreur Solver: Pivot nul a l'indice " + std::to_string(n - 1));
+            }
+            e[n - 1] = a[n - 1] / pivot;
+            f[n - 1] = d[n - 1] / pivot;
+            for (size_t i = n - 2; i != static_cast<size_t>(-1); --i) {
+                double denominator = b[i] - c[i] * e[i + 1];
+                if (std::abs(denominator) < kPivotTolerance) {
+                    throw std::runtime_error("Erreur Solver: Pivot nul a l'indice " + std::to_string(i));
+                }
+                double temp = 1.0 / denominator;
+                e[i] = a[i] * temp;
+                f[i] = (d[i] - c[i] * f[i + 1]) * temp;
+            }
+
+            x[0] = std::max(g[0], f[0]);
+            for (size_t i = 1; i < n; ++i) {
+                x[i] = std::max(g[i], f[i] - e[i] * x[i - 1]);
+            }
+        }
+    }
+
+    size_t projectedSOR(const std::vector<double>& a,
+                        const std::vector<double>& b,
+                        const std::vector<double>& c,
+                        const std::vector<double>& d,
+                        const std::vector<double>& g,
+                        std::vector<double>& x,
+                        double omega,
+                        double tolerance,
+                        size_t max_iter) {
+        size_t n = d.size();
+
+        if (n == 0) {
+            throw std::invalid_argument("Erreur Solver: Le systeme est vide.");
+        }
+        if (a.size() != n || b.size() != n || c.size() != n || g.size() != n) {
+            throw std::invalid_argument("Erreur Solver: Dimensions des vecteurs a, b, c, g incoherentes.");
+        }
+        if (!(omega > 0.0 && omega < 2.0)) {
+            throw std::invalid_argument("Erreur Solver: Parametre de relaxation hors de ]0, 2[.");
+        }
+        if (x.size() != n) {
+            x.assign(g.begin(), g.end());
+        }
+
+        for (size_t iter = 1; iter <= max_iter; ++iter) {
+            double error = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                double sum = d[i];
+                if (i > 0)     sum -= a[i] * x[i - 1];
+                if (i < n - 1) sum -= c[i] * x[i + 1];
+
+                // Gauss-Seidel sur-relaxé puis projection sur l'obstacle
+                double gs = sum / b[i];
+                double updated = std::max(g[i], x[i] + omega * (gs - x[i]));
+                error = std::max(error, std::abs(updated - x[i]) / std::max(1.0, std::abs(updated)));
+                x[i] = updated;
+            }
+            if (error < tolerance) {
+                return iter;
+            }
+        }
+        throw std::runtime_error("Erreur Solver: PSOR n'a pas converge.");
+    }
+
+} // namespace edp
@@ -0,0 +1,68 @@
+#include "edp/LocalVolSurface.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace edp {
+
+LocalVolSurface::LocalVolSurface(const std::vector<double>& times_,
+                                 const std::vector<double>& spots_,
+                                 const std::vector<double>& vols_)
+    : times(times_), spots(spots_), vols(vols_) {
+    if (times.empty() || spots.empty() || vols.size() != times.size() * spots.size()) {
+        throw std::invalid_argument("Erreur Surface: Dimensions incoherentes (tranches x spots).");
+    }
+    for (size_t k = 0; k < times.size(); ++k) {
+        double previous = (k == 0) ? 0.0 : times[k - 1];
+        if (!(times[k] > previous)) {
+            throw std::invalid_argument("Erreur Surface: Tranches non strictement croissantes et positives.");
+        }
+    }
+    for (size_t j = 1; j < spots.size(); ++j) {
+        if (!(spots[j] > spots[j - 1])) {
+            throw std::invalid_argument("Erreur Surface: Spots non strictement croissants.");
+        }
+    }
+    for (double v : vols) {
+        if (!(v > 0.0)) {
+            throw std::invalid_argument("Erreur Surface: Volatilite non positive.");
+        }
+    }
+}
+
+size_t LocalVolSurface::sliceIndex(double t) const {
+    auto it = std::lower_bound(times.begin(), times.end(), t);
+    if (it == times.end()) {
+        return times.size() - 1;
+    }
+    return static_cast<size_t>(it - times.begin());
+}
+
+void LocalVolSurface::sample(double t, const std::vector<double>& S, std::vector<double>& out) const {
+    const double* slice = &vols[sliceIndex(t) * spots.size()];
+    const size_t n_spots = spots.size();
+    out.resize(S.size());
+
+    size_t j = 0; // spots[j] <= S[i] < spots[j+1]
+    for (size_t i = 0; i < S.size(); ++i) {
+        double s = S[i];
+        if (s <= spots.front()) {
+            out[i] = slice[0];
+            continue;
+        }
+        if (s >= spots.back()) {
+            out[i] = slice[n_spots - 1];
+            continue;
+        }
+        while (spots[j + 1] <= s) ++j;
+        double w = (s - spots[j]) / (spots[j + 1] - spots[j]);
+        out[i] = slice[j] + w * (slice[j + 1] - slice[j]);
+    }
+}
+
+double LocalVolSurface::operator()(double S, double t) const {
+    std::vector<double> out;
+    sample(t, std::vector<double>{S}, out);
+    return out[0];
+}
+
+} // namespace edp
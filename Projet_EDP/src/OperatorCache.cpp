@@ -0,0 +1,79 @@
+#include "edp/OperatorCache.h"
+#include <functional>
+
+namespace edp {
+
+namespace {
+
+    inline void hashCombine(size_t& seed, size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+
+    template <typename T>
+    size_t vectorBytes(const std::vector<T>& v) {
+        return v.capacity() * sizeof(T);
+    }
+
+} // namespace
+
+size_t byteSize(const PreparedGrid& g) {
+    return sizeof(PreparedGrid) + vectorBytes(g.grid.nodes()) + vectorBytes(g.S);
+}
+
+size_t byteSize(const ThetaOperator& op) {
+    size_t bytes = sizeof(ThetaOperator) + op.A_factor.byteSize();
+    for (const auto* v : {&op.A_lower, &op.A_diag, &op.A_upper, &op.B_lower, &op.B_diag, &op.B_upper,
+                          &op.dLs_lower, &op.dLs_diag, &op.dLs_upper, &op.dLr_lower, &op.dLr_diag, &op.dLr_upper}) {
+        bytes += vectorBytes(*v);
+    }
+    return bytes;
+}
+
+size_t GridKeyHash::operator()(const GridKey& k) const {
+    std::hash<double> hd;
+    size_t seed = static_cast<size_t>(k.type);
+    hashCombine(seed, hd(k.x_min));
+    hashCombine(seed, hd(k.x_max));
+    hashCombine(seed, std::hash<size_t>()(k.N));
+    hashCombine(seed, hd(k.center));
+    hashCombine(seed, hd(k.alpha));
+    for (double x : k.nodes) {
+        hashCombine(seed, hd(x));
+    }
+    return seed;
+}
+
+size_t OperatorKeyHash::operator()(const OperatorKey& k) const {
+    std::hash<double> hd;
+    size_t seed = GridKeyHash()(k.grid);
+    hashCombine(seed, hd(k.r));
+    hashCombine(seed, hd(k.sigma));
+    hashCombine(seed, hd(k.step));
+    hashCombine(seed, hd(k.theta));
+    hashCombine(seed, static_cast<size_t>(k.sensitivities));
+    return seed;
+}
+
+OperatorCache::OperatorCache() : grids(32, 16u << 20), operators(64, 64u << 20) {}
+
+OperatorCache& OperatorCache::instance() {
+    static OperatorCache cache;
+    return cache;
+}
+
+void OperatorCache::setCapacity(size_t grid_capacity, size_t operator_capacity) {
+    grids.setCapacity(grid_capacity);
+    operators.setCapacity(operator_capacity);
+}
+
+void OperatorCache::setCapacityBytes(size_t grid_bytes, size_t operator_bytes) {
+    grids.setCapacityBytes(grid_bytes);
+    operators.setCapacityBytes(operator_bytes);
+}
+
+void OperatorCache::clear() {
+    grids.clear();
+    operators.clear();
+}
+
+} // namespace edp
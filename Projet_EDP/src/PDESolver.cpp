@@ -1,47 +1,422 @@
 #include "edp/PDESolver.h"
 #include "edp/LinearSolver.h" 
+#include "edp/BlackScholes.h"
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <numeric>
 #include <stdexcept>
+#include <thread>
 
 namespace edp {
 
+namespace {
+
+    // Précisions Float et Mixed : valeurs ramenées à 0 sous ce seuil à chaque pas. Les ailes
+    // lointaines (~1e-40 et moins) tomberaient sinon dans les dénormaux du float,
+    // dont l'arithmétique est des dizaines de fois plus lente, bien avant de compter
+    // dans un prix (erreur float relative ~1e-7).
+    constexpr float kFloatFlushThreshold = 1e-30f;
+
+    // Lignes [begin, end) de A, B (et dL) en volatilité locale.
+    // Boucle fusionnée sans branchement sur des tableaux contigus (vectorisable) ;
+    // la géométrie D1/D2 de chaque ligne est précalculée une fois par grille.
+    // sig[i] : volatilité au noeud central de la ligne i.
+    void assembleLocalVolRows(size_t begin, size_t end, double step, double theta, double r,
+                              const double* sig,
+                              const double* d1l, const double* d1d, const double* d1u,
+                              const double* d2l, const double* d2d, const double* d2u,
+                              ThetaOperator& out, bool sensitivities) {
+        double* Al = out.A_lower.data();
+        double* Ad = out.A_diag.data();
+        double* Au = out.A_upper.data();
+        double* Bl = out.B_lower.data();
+        double* Bd = out.B_diag.data();
+        double* Bu = out.B_upper.data();
+        const double theta_explicit = 1.0 - theta;
+
+        for (size_t i = begin; i < end; ++i) {
+            double half_var = 0.5 * sig[i] * sig[i];
+            double nu = r - half_var;
+            double L_lower = step * (half_var * d2l[i] + nu * d1l[i]);
+            double L_diag  = step * (half_var * d2d[i] + nu * d1d[i] - r);
+            double L_upper = step * (half_var * d2u[i] + nu * d1u[i]);
+
+            Al[i] = -theta * L_lower;
+            Ad[i] = 1.0 - theta * L_diag;
+            Au[i] = -theta * L_upper;
+            Bl[i] = theta_explicit * L_lower;
+            Bd[i] = 1.0 + theta_explicit * L_diag;
+            Bu[i] = theta_explicit * L_upper;
+        }
+
+        if (sensitivities) {
+            double* sl = out.dLs_lower.data();
+            double* sd = out.dLs_diag.data();
+            double* su = out.dLs_upper.data();
+            double* rl = out.dLr_lower.data();
+            double* rd = out.dLr_diag.data();
+            double* ru = out.dLr_upper.data();
+            for (size_t i = begin; i < end; ++i) {
+                double scale = step * sig[i];
+                sl[i] = scale * (d2l[i] - d1l[i]);
+                sd[i] = scale * (d2d[i] - d1d[i]);
+                su[i] = scale * (d2u[i] - d1u[i]);
+                rl[i] = step * d1l[i];
+                rd[i] = step * (d1d[i] - 1.0);
+                ru[i] = step * d1u[i];
+            }
+        }
+    }
+
+} // namespace
+
 // Constructeur : Initialisation des paramètres
 PDESolver::PDESolver(double T_, double r_, double sigma_, 
                      double S_max_, double theta_scheme_, 
                      size_t N_, size_t M_)
     : T(T_), r(r_), sigma(sigma_), 
       S_max(S_max_), theta_scheme(theta_scheme_), 
-      N(N_), M(M_) {
-    
+      N(N_), M(M_),
+      parallel_threshold(100000),
+      parallel_threads(std::max(1u, std::thread::hardware_concurrency())) {
+    reset(T_, r_, sigma_, S_max_, theta_scheme_, N_, M_);
+}
+
+// Nouveaux paramètres sur le même solveur : grille conservée si elle ne change pas,
+// espaces de travail réutilisés (aucune allocation à N constant)
+void PDESolver::reset(double T_, double r_, double sigma_,
+                      double S_max_, double theta_scheme_,
+                      size_t N_, size_t M_, double S_min_) {
+    if (S_min_ > 0.0 && !(S_min_ < S_max_)) {
+        throw std::invalid_argument("Erreur PDESolver: Domaine vide (S_min >= S_max).");
+    }
+    T = T_;
+    r = r_;
+    sigma = sigma_;
+    S_max = S_max_;
+    theta_scheme = theta_scheme_;
+    N = N_;
+    M = M_;
+
     // Calcul des pas de discrétisation
     dt = T / static_cast<double>(M);
     
     // Grille logarithmique : x = ln(S)
     // On évite log(0) en prenant une borne basse petite mais strictement positive
-    double S_min = S_max / 3000.0; 
+    // (S_max / 3000 par défaut, ou la borne fournie : domaine automatique)
+    double S_min = (S_min_ > 0.0) ? S_min_ : S_max / 3000.0;
     double x_min = std::log(S_min); 
     double x_max = std::log(S_max);
     
-    dx = (x_max - x_min) / static_cast<double>(N - 1);
+    GridKey key;
+    key.type = GridType::Uniform;
+    key.x_min = x_min;
+    key.x_max = x_max;
+    key.N = N;
+    if (!prepared || !(key == grid_key)) {
+        setGrid(key);
+    } else {
+        S_max = prepared->S[N-1];
+    }
 }
 
-// Pré-calcul des matrices A (Implicite) et B (Explicite)
-// Basé sur le Theta-Schéma généralisé
+// Installe la grille (partagée via le cache) et (re)dimensionne les espaces de travail.
+// Alloués une fois pour toutes tant que N ne change pas.
+void PDESolver::setGrid(const GridKey& key) {
+    phase_clock.restart();
+    auto build = [this, &key] {
+        if constexpr (SolveStats::enabled) ++stats.allocations;
+        auto g = std::make_shared<PreparedGrid>();
+        switch (key.type) {
+            case GridType::Uniform: g->grid = LogGrid::uniform(key.x_min, key.x_max, key.N); break;
+            case GridType::Sinh:    g->grid = LogGrid::sinh(key.x_min, key.x_max, key.N, key.center, key.alpha); break;
+            case GridType::Custom:  g->grid = LogGrid::custom(key.nodes); break;
+        }
+        g->S.resize(g->grid.size());
+        for (size_t i = 0; i < g->S.size(); ++i) {
+            g->S[i] = std::exp(g->grid[i]);
+        }
+        return std::shared_ptr<const PreparedGrid>(std::move(g));
+    };
+    prepared = use_cache ? OperatorCache::instance().grids.getOrBuild(key, build) : build();
+    grid_key = key;
+
+    const LogGrid& grid = prepared->grid;
+    N = grid.size();
+    dx = grid.isUniform() ? grid.uniformStep() : 0.0;
+    S_max = prepared->S[N-1];
+
+    V.resize(N);
+    V_prev.resize(N);
+    d.resize(N - 2);
+    V_solve.resize(N - 2);
+
+    // Nouvelle grille : l'opérateur courant n'est plus valable
+    op = nullptr;
+    op_dt = 0.0;
+    op_theta = -1.0;
+    phase_clock.lap(SolvePhase::Grid);
+}
+
+void PDESolver::setDomain(double S_min_, double S_max_) {
+    if (!(S_min_ > 0.0)) {
+        throw std::invalid_argument("Erreur PDESolver: Borne basse du domaine non positive.");
+    }
+    reset(T, r, sigma, S_max_, theta_scheme, N, M, S_min_);
+}
+
+void PDESolver::setSinhGrid(double S_center, double alpha) {
+    if (!(S_center > 0.0)) {
+        throw std::invalid_argument("Erreur PDESolver: Centre de grille non positif.");
+    }
+    GridKey key;
+    key.type = GridType::Sinh;
+    key.x_min = prepared->grid[0];
+    key.x_max = prepared->grid[N-1];
+    key.N = N;
+    key.center = std::log(S_center);
+    key.alpha = alpha;
+    setGrid(key);
+}
+
+void PDESolver::setGridNodes(const std::vector<double>& S_nodes) {
+    GridKey key;
+    key.type = GridType::Custom;
+    key.nodes.resize(S_nodes.size());
+    for (size_t i = 0; i < S_nodes.size(); ++i) {
+        if (!(S_nodes[i] > 0.0)) {
+            throw std::invalid_argument("Erreur PDESolver: Noeud de grille non positif.");
+        }
+        key.nodes[i] = std::log(S_nodes[i]);
+    }
+    key.N = key.nodes.size();
+    if (key.N > 0) {
+        key.x_min = key.nodes.front();
+        key.x_max = key.nodes.back();
+    }
+    setGrid(key);
+}
+
+void PDESolver::setUseCache(bool enabled) {
+    use_cache = enabled;
+}
+
+void PDESolver::setShareOperators(bool enabled) {
+    share_operators = enabled;
+}
+
+void PDESolver::setComputeSensitivities(bool enabled) {
+    compute_sensitivities = enabled;
+}
+
+void PDESolver::setParallelThreshold(size_t threshold, unsigned nThreads) {
+    parallel_threshold = threshold;
+    parallel_threads = (nThreads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : nThreads;
+}
+
+// Pré-calcul des matrices pour le premier pas de la grille temporelle
 void PDESolver::precomputeMatrices() {
+    prepareSegments();
+    cur_r = segment_r[0];
+    cur_sigma = segment_sigma[0];
+    if (local_vol) {
+        // Nouvel échantillonnage complet (la grille a pu changer)
+        lv_sigma.clear();
+        sampleLocalVol(T - 0.5 * segment_ends[0]);
+    }
+
+    double h = initialStep();
+    if (rannacher_steps > 0) {
+        assembleOperator(0.5 * h, 1.0);
+    } else {
+        assembleOperator(h, theta_scheme);
+    }
+}
+
+// Assemble l'opérateur seulement si le pas ou le schéma change
+void PDESolver::prepareOperator(double step, double theta) {
+    bool coefficients_changed = local_vol ? (lv_dirty_begin < lv_dirty_end) : (cur_sigma != op_sigma);
+    if (step != op_dt || theta != op_theta || cur_r != op_r || coefficients_changed) {
+        assembleOperator(step, theta);
+    }
+}
+
+// Opérateur du pas 'step' au schéma 'theta' : lu dans le cache partagé, ou construit.
+// Pas géométriques ou adaptatifs : chaque pas est unique, son opérateur ne ferait
+// qu'évincer du cache ceux qui resservent ; il est assemblé dans own_op.
+void PDESolver::assembleOperator(double step, double theta) {
+    size_t systemSize = N - 2;
+    if (compute_sensitivities) {
+        U_sigma.resize(N);
+        U_r.resize(N);
+        d_sigma.resize(systemSize);
+        d_r.resize(systemSize);
+    }
+
+    if (local_vol) {
+        assembleLocalVol(step, theta);
+    } else if (use_cache && share_operators && time_stepping == TimeStepping::Uniform) {
+        op_key.grid = grid_key;
+        op_key.r = cur_r;
+        op_key.sigma = cur_sigma;
+        op_key.step = step;
+        op_key.theta = theta;
+        op_key.sensitivities = compute_sensitivities;
+        cached_op = OperatorCache::instance().operators.getOrBuild(op_key, [&] {
+            auto built = std::make_shared<ThetaOperator>();
+            buildOperator(step, theta, *built);
+            ++factorizations;
+            if constexpr (SolveStats::enabled) ++stats.allocations;
+            return std::shared_ptr<const ThetaOperator>(std::move(built));
+        });
+        op = cached_op.get();
+    } else {
+        buildOperator(step, theta, own_op);
+        ++factorizations;
+        op = &own_op;
+    }
+
+    // Grande grille : partition du système sur plusieurs threads
+    // (solveur propre à chaque PDESolver : son espace de travail n'est pas partageable)
+    use_parallel = (systemSize >= parallel_threshold && parallel_threads > 1);
+    if (use_parallel) {
+        A_parallel.factorize(op->A_lower, op->A_diag, op->A_upper, parallel_threads);
+    }
+
+    op_dt = step;
+    op_theta = theta;
+    op_r = cur_r;
+    op_sigma = cur_sigma;
+    float_op_stale = true;
+}
+
+// Volatilité locale : opérateur propre au solveur, mis à jour en place.
+// Seules les lignes dont la volatilité a changé depuis le dernier assemblage sont
+// recalculées, et l'élimination reprend à la première d'entre elles.
+// Assemblage complet si le pas, le schéma, le taux ou la grille changent.
+void PDESolver::assembleLocalVol(double step, double theta) {
+    const size_t n = N - 2;
+
+    // Géométrie D1/D2 des lignes, une fois par grille
+    if (geometry_grid != prepared.get()) {
+        const LogGrid& grid = prepared->grid;
+        for (auto* v : {&geo_d1l, &geo_d1d, &geo_d1u, &geo_d2l, &geo_d2d, &geo_d2u}) {
+            v->resize(n);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            double h_m = grid[i+1] - grid[i];
+            double h_p = grid[i+2] - grid[i+1];
+            geo_d1l[i] = -h_p / (h_m * (h_m + h_p));
+            geo_d1d[i] = (h_p - h_m) / (h_m * h_p);
+            geo_d1u[i] = h_m / (h_p * (h_m + h_p));
+            geo_d2l[i] = 2.0 / (h_m * (h_m + h_p));
+            geo_d2d[i] = -2.0 / (h_m * h_p);
+            geo_d2u[i] = 2.0 / (h_p * (h_m + h_p));
+        }
+        geometry_grid = prepared.get();
+        op = nullptr;
+    }
+
+    const bool sensitivities_ready = !compute_sensitivities || own_op.dLs_diag.size() == n;
+    const bool full = (op != &own_op) || step != op_dt || theta != op_theta || cur_r != op_r
+                   || own_op.A_diag.size() != n || !sensitivities_ready;
+
+    // Noeuds modifiés [lv_dirty_begin, lv_dirty_end) -> lignes (noeud j = ligne j - 1)
+    size_t row_begin = 0, row_end = n;
+    if (full) {
+        for (auto* v : {&own_op.A_lower, &own_op.A_diag, &own_op.A_upper,
+                        &own_op.B_lower, &own_op.B_diag, &own_op.B_upper}) {
+            v->resize(n);
+        }
+        if (compute_sensitivities) {
+            for (auto* v : {&own_op.dLs_lower, &own_op.dLs_diag, &own_op.dLs_upper,
+                            &own_op.dLr_lower, &own_op.dLr_diag, &own_op.dLr_upper}) {
+                v->resize(n);
+            }
+        }
+    } else {
+        row_begin = std::min(n, std::max<size_t>(lv_dirty_begin, 1) - 1);
+        row_end = std::min(n, std::max<size_t>(lv_dirty_end, 1) - 1);
+        if (lv_dirty_end >= N - 1) row_end = n;
+    }
+
+    assembleLocalVolRows(row_begin, row_end, step, theta, cur_r, lv_sigma.data() + 1,
+                         geo_d1l.data(), geo_d1d.data(), geo_d1u.data(),
+                         geo_d2l.data(), geo_d2d.data(), geo_d2u.data(),
+                         own_op, compute_sensitivities);
+    assembled_rows += row_end - row_begin;
+
+    if (full) {
+        own_op.A_factor.factorize(own_op.A_lower, own_op.A_diag, own_op.A_upper);
+    } else {
+        own_op.A_factor.refactorize(own_op.A_lower, own_op.A_diag, own_op.A_upper, row_begin);
+    }
+    ++factorizations;
+
+    lv_dirty_begin = lv_dirty_end = 0;
+    op = &own_op;
+}
+
+// Échantillonne la surface à l'instant calendaire t sur la grille et repère
+// la plage de noeuds dont la volatilité a changé (vide : opérateur réutilisé tel quel)
+void PDESolver::sampleLocalVol(double t) {
+    local_vol->sample(t, prepared->S, lv_sample);
+
+    if (lv_sigma.size() != N) {
+        lv_dirty_begin = 0;
+        lv_dirty_end = N;
+    } else {
+        size_t first = 0, last = N;
+        while (first < N && lv_sample[first] == lv_sigma[first]) ++first;
+        while (last > first && lv_sample[last - 1] == lv_sigma[last - 1]) --last;
+        if (first < last) {
+            if (lv_dirty_begin < lv_dirty_end) {
+                // Plage encore en attente d'assemblage : union des deux
+                lv_dirty_begin = std::min(lv_dirty_begin, first);
+                lv_dirty_end = std::max(lv_dirty_end, last);
+            } else {
+                lv_dirty_begin = first;
+                lv_dirty_end = last;
+            }
+        }
+    }
+    lv_sigma.swap(lv_sample);
+}
+
+// Matrices A (Implicite) et B (Explicite) pour un pas 'step' du theta-schéma, puis factorisation de A
+// Basé sur le Theta-Schéma généralisé
+void PDESolver::buildOperator(double step, double theta, ThetaOperator& out) const {
+    std::vector<double>& A_lower = out.A_lower;
+    std::vector<double>& A_diag  = out.A_diag;
+    std::vector<double>& A_upper = out.A_upper;
+    std::vector<double>& B_lower = out.B_lower;
+    std::vector<double>& B_diag  = out.B_diag;
+    std::vector<double>& B_upper = out.B_upper;
+    std::vector<double>& dLs_lower = out.dLs_lower;
+    std::vector<double>& dLs_diag  = out.dLs_diag;
+    std::vector<double>& dLs_upper = out.dLs_upper;
+    std::vector<double>& dLr_lower = out.dLr_lower;
+    std::vector<double>& dLr_diag  = out.dLr_diag;
+    std::vector<double>& dLr_upper = out.dLr_upper;
+    const LogGrid& grid = prepared->grid;
+
+    // Coefficients du segment de structure par terme courant
+    const double r = cur_r;
+    const double sigma = cur_sigma;
+
     // Paramètres de l'équation transformée (Log-space)
     // dV/dt + (r - sigma^2/2) dV/dx + 1/2 sigma^2 d2V/dx2 - rV = 0
     double sigma2 = sigma * sigma;
     double nu = r - 0.5 * sigma2; // Drift sous log-measure
 
-    // Coefficients de discrétisation de base (sans Theta)
+    // Coefficients de discrétisation de base (sans Theta), grille uniforme
     // Diffusion : coeff devant d2V/dx2 * dt/dx^2
-    double lambda = (sigma2 * dt) / (dx * dx); 
+    double lambda = (sigma2 * step) / (dx * dx); 
     // Convection : coeff devant dV/dx * dt/(2dx) (Différences finies centrées)
-    double gamma  = (nu * dt) / (2.0 * dx); 
+    double gamma  = (nu * step) / (2.0 * dx); 
     // Réaction : r * dt
-    double rho    = r * dt;
+    double rho    = r * step;
 
     size_t systemSize = N - 2;
     
@@ -53,6 +428,15 @@ void PDESolver::precomputeMatrices() {
     B_diag.resize(systemSize);
     B_upper.resize(systemSize);
 
+    if (compute_sensitivities) {
+        dLs_lower.resize(systemSize);
+        dLs_diag.resize(systemSize);
+        dLs_upper.resize(systemSize);
+        dLr_lower.resize(systemSize);
+        dLr_diag.resize(systemSize);
+        dLr_upper.resize(systemSize);
+    }
+
     // Construction des matrices selon le Theta-scheme
     // LHS (A) : Partie Future (Implicite) -> Poids theta
     // RHS (B) : Partie Passée (Explicite) -> Poids (1 - theta)
@@ -61,125 +445,1029 @@ void PDESolver::precomputeMatrices() {
     // V_old = V_new + dt * L(V)
     // V_old = (I - (1-theta) dt L) V_n + (theta dt L) V_{n+1} ... 
     // La convention standard pour A * V_{new} = B * V_{old} donne :
+    // A = I - theta dt L, B = I + (1 - theta) dt L
 
+    const bool uniform = grid.isUniform();
     for (size_t i = 0; i < systemSize; ++i) {
+        // Pas à gauche et à droite du noeud i+1
+        double h_m = uniform ? dx : grid[i+1] - grid[i];
+        double h_p = uniform ? dx : grid[i+2] - grid[i+1];
+
+        // Différences centrées D1 (dV/dx) et D2 (d2V/dx2) sur pas variables
+        double d1_l = -h_p / (h_m * (h_m + h_p));
+        double d1_d = (h_p - h_m) / (h_m * h_p);
+        double d1_u = h_m / (h_p * (h_m + h_p));
+        double d2_l = 2.0 / (h_m * (h_m + h_p));
+        double d2_d = -2.0 / (h_m * h_p);
+        double d2_u = 2.0 / (h_p * (h_m + h_p));
+
+        // Ligne de dt * L (Diffusion + Convection + Réaction)
+        double L_lower, L_diag, L_upper;
+        if (uniform) {
+            L_lower = 0.5 * lambda - gamma;
+            L_diag  = -(lambda + rho);
+            L_upper = 0.5 * lambda + gamma;
+        } else {
+            L_lower = step * (0.5 * sigma2 * d2_l + nu * d1_l);
+            L_diag  = step * (0.5 * sigma2 * d2_d + nu * d1_d - r);
+            L_upper = step * (0.5 * sigma2 * d2_u + nu * d1_u);
+        }
+
         // --- Matrice A (Gauche - Implicite) ---
         // Diagonale : 1 + theta * (termes sortants)
-        A_lower[i] = theta_scheme * (-0.5 * lambda + gamma); 
-        A_diag[i]  = 1.0 + theta_scheme * (lambda + rho);
-        A_upper[i] = theta_scheme * (-0.5 * lambda - gamma);
+        A_lower[i] = -theta * L_lower; 
+        A_diag[i]  = 1.0 - theta * L_diag;
+        A_upper[i] = -theta * L_upper;
 
         // --- Matrice B (Droite - Explicite) ---
         // Diagonale : 1 - (1-theta) * (termes sortants)
-        B_lower[i] = (1.0 - theta_scheme) * (0.5 * lambda - gamma);
-        B_diag[i]  = 1.0 - (1.0 - theta_scheme) * (lambda + rho);
-        B_upper[i] = (1.0 - theta_scheme) * (0.5 * lambda + gamma);
+        B_lower[i] = (1.0 - theta) * L_lower;
+        B_diag[i]  = 1.0 + (1.0 - theta) * L_diag;
+        B_upper[i] = (1.0 - theta) * L_upper;
+
+        // Dérivées de l'opérateur (multipliées par dt) pour les équations tangentes :
+        // dL/dsigma = sigma (D2 - D1) et dL/dr = D1 - I
+        if (compute_sensitivities) {
+            dLs_lower[i] = step * sigma * (d2_l - d1_l);
+            dLs_diag[i]  = step * sigma * (d2_d - d1_d);
+            dLs_upper[i] = step * sigma * (d2_u - d1_u);
+
+            dLr_lower[i] = step * d1_l;
+            dLr_diag[i]  = step * (d1_d - 1.0);
+            dLr_upper[i] = step * d1_u;
+        }
+    }
+
+    // A ne change qu'avec le pas de temps : factorisée une fois par pas distinct
+    out.A_factor.factorize(A_lower, A_diag, A_upper);
+}
+
+void PDESolver::setRateCurve(const PiecewiseConstantCurve& curve) {
+    rate_curve = std::make_shared<const PiecewiseConstantCurve>(curve);
+}
+
+void PDESolver::setVolatilityCurve(const PiecewiseConstantCurve& curve) {
+    vol_curve = std::make_shared<const PiecewiseConstantCurve>(curve);
+}
+
+void PDESolver::setLocalVolatility(const LocalVolSurface& surface) {
+    local_vol = std::make_shared<const LocalVolSurface>(surface);
+    op = nullptr;
+}
+
+void PDESolver::setRannacherSteps(size_t steps) {
+    rannacher_steps = steps;
+}
+
+void PDESolver::setUniformTimeGrid() {
+    time_stepping = TimeStepping::Uniform;
+}
+
+void PDESolver::setGeometricTimeGrid(double growth) {
+    if (!(growth >= 1.0)) {
+        throw std::invalid_argument("Erreur PDESolver: Facteur de croissance du pas inferieur a 1.");
+    }
+    time_stepping = TimeStepping::Geometric;
+    time_growth = growth;
+}
+
+void PDESolver::setAdaptiveTimeGrid(double target_change) {
+    if (!(target_change > 0.0)) {
+        throw std::invalid_argument("Erreur PDESolver: Variation cible non positive.");
+    }
+    time_stepping = TimeStepping::Adaptive;
+    step_target = target_change;
+}
+
+// Premier pas (près de la maturité)
+double PDESolver::initialStep() const {
+    switch (time_stepping) {
+        case TimeStepping::Uniform:
+            // Pas uniforme du premier segment
+            return (segment_steps[0] > 0) ? segment_ends[0] / static_cast<double>(segment_steps[0]) : dt;
+        case TimeStepping::Geometric: {
+            // dt0 (1 + g + ... + g^{M-1}) = T
+            if (time_growth == 1.0 || M == 0) return dt;
+            return T * (time_growth - 1.0) / (std::pow(time_growth, static_cast<double>(M)) - 1.0);
+        }
+        case TimeStepping::Adaptive:
+            // Pas initial petit devant T/M : le payoff non régulier varie vite au départ
+            return 0.1 * dt;
+    }
+    return dt;
+}
+
+// Pas suivant. Adaptatif (Forsyth) : h_new = h * cible / variation relative du pas écoulé,
+// borné à [h/2, 2h] ; un changement de moins de 20 % est ignoré (pas de refactorisation).
+double PDESolver::nextStep(double h, double change) const {
+    switch (time_stepping) {
+        case TimeStepping::Uniform:
+            return dt;
+        case TimeStepping::Geometric:
+            return h * time_growth;
+        case TimeStepping::Adaptive: {
+            double proposed = (change > 0.0) ? h * step_target / change : 2.0 * h;
+            proposed = std::min(2.0 * h, std::max(0.5 * h, proposed));
+            return (std::fabs(proposed - h) < 0.2 * h) ? h : proposed;
+        }
+    }
+    return dt;
+}
+
+// Segments de la structure par terme en temps restant tau = T - t :
+// réunion des noeuds de r(t) et sigma(t) dans ]0, T[, valeurs constantes sur chacun.
+// Sans courbe : un seul segment [0, T] aux valeurs scalaires r et sigma.
+void PDESolver::prepareSegments() {
+    segment_ends.clear();
+    if (rate_curve) {
+        for (double t : rate_curve->getKnots()) {
+            if (t > 0.0 && t < T) segment_ends.push_back(T - t);
+        }
+    }
+    if (vol_curve) {
+        for (double t : vol_curve->getKnots()) {
+            if (t > 0.0 && t < T) segment_ends.push_back(T - t);
+        }
+    }
+    if (local_vol) {
+        for (double t : local_vol->getTimes()) {
+            if (t > 0.0 && t < T) segment_ends.push_back(T - t);
+        }
+    }
+    std::sort(segment_ends.begin(), segment_ends.end());
+    segment_ends.erase(std::unique(segment_ends.begin(), segment_ends.end()), segment_ends.end());
+    segment_ends.push_back(T);
+
+    size_t n_segments = segment_ends.size();
+    segment_r.resize(n_segments);
+    segment_sigma.resize(n_segments);
+    segment_steps.resize(n_segments);
+
+    double start = 0.0;
+    for (size_t j = 0; j < n_segments; ++j) {
+        // Valeur au milieu du segment (calendaire) : constante sur tout le segment
+        double t_mid = T - 0.5 * (start + segment_ends[j]);
+        segment_r[j] = rate_curve ? rate_curve->value(t_mid) : r;
+        segment_sigma[j] = vol_curve ? vol_curve->value(t_mid) : sigma;
+        start = segment_ends[j];
+    }
+
+    // Grille uniforme : M pas répartis au prorata des longueurs, au moins 1 par segment,
+    // par la méthode des plus forts restes : la somme vaut exactement M (sauf M < nombre
+    // de segments). Le pas minimal des segments courts est repris aux plus faibles restes.
+    if (n_segments == 1 || M == 0) {
+        std::fill(segment_steps.begin(), segment_steps.end(), M);
+        return;
+    }
+    if (M <= n_segments) {
+        std::fill(segment_steps.begin(), segment_steps.end(), size_t{1});
+        return;
+    }
+    std::vector<double> remainder(n_segments);
+    size_t allocated = 0;
+    start = 0.0;
+    for (size_t j = 0; j < n_segments; ++j) {
+        double share = static_cast<double>(M) * (segment_ends[j] - start) / T;
+        segment_steps[j] = std::max<size_t>(1, static_cast<size_t>(share));
+        remainder[j] = share - static_cast<double>(segment_steps[j]);
+        allocated += segment_steps[j];
+        start = segment_ends[j];
+    }
+    std::vector<size_t> order(n_segments);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return remainder[a] > remainder[b]; });
+    for (size_t k = 0; allocated < M; k = (k + 1) % n_segments) {
+        ++segment_steps[order[k]];
+        ++allocated;
+    }
+    for (size_t k = n_segments; allocated > M; k = (k == 0 ? n_segments : k) - 1) {
+        // Excédent dû aux minimums : retiré aux plus faibles restes encore à plus d'un pas
+        if (k < n_segments && segment_steps[order[k]] > 1) {
+            --segment_steps[order[k]];
+            --allocated;
+        }
+    }
+}
+
+// Actualisation intégrée sur les tau derniers instants avant maturité : int_{T-tau}^{T} r(t) dt
+double PDESolver::discountExponent(double tau) const {
+    return rate_curve ? rate_curve->integral(T - tau, T) : r * tau;
+}
+
+// Boucle temporelle commune (solve simple et solve par lot).
+// advance(pas, theta, temps_suivant, dernier) avance la solution et renvoie la
+// variation relative max du pas (utilisée seulement en mode adaptatif).
+// Pas de Rannacher : chacun des premiers pas est remplacé par deux demi-pas implicites.
+// Les pas tombent exactement sur les noeuds de la structure par terme : l'opérateur
+// (r, sigma du segment) n'est refactorisé qu'au changement de segment ou de pas.
+template <typename AdvanceFn>
+void PDESolver::timeLoop(AdvanceFn&& advance) {
+    steps_taken = 0;
+    double tau = 0.0;
+    double h = initialStep();
+    size_t k = 0; // Indice du pas (pour Rannacher)
+
+    auto step = [&](double h_step, double time_next, bool last) {
+        double change;
+        if (k < rannacher_steps) {
+            change  = advance(0.5 * h_step, 1.0, tau + 0.5 * h_step, false);
+            change += advance(0.5 * h_step, 1.0, time_next, last);
+        } else {
+            change = advance(h_step, theta_scheme, time_next, last);
+        }
+        ++k;
+        ++steps_taken;
+        if constexpr (SolveStats::enabled) ++stats.steps;
+        tau = time_next;
+        return change;
+    };
+
+    const size_t n_segments = segment_ends.size();
+    for (size_t seg = 0; seg < n_segments; ++seg) {
+        cur_r = segment_r[seg];
+        cur_sigma = segment_sigma[seg];
+        const double seg_start = tau;
+        if (local_vol && seg > 0) {
+            // Une tranche de surface par segment : échantillonnée une fois
+            sampleLocalVol(T - 0.5 * (seg_start + segment_ends[seg]));
+        }
+        const double seg_end = segment_ends[seg];
+        const bool last_segment = (seg + 1 == n_segments);
+
+        if (time_stepping == TimeStepping::Uniform) {
+            // Pas constant dans le segment (T / M sans structure par terme)
+            const size_t n = segment_steps[seg];
+            const double h_seg = (n_segments == 1) ? dt : (seg_end - seg_start) / static_cast<double>(n);
+            for (size_t i = 0; i < n; ++i) {
+                // Temps restant jusqu'à maturité pour la prochaine étape
+                double time_next = (i + 1 == n && !last_segment) ? seg_end : seg_start + (i + 1) * h_seg;
+                step(h_seg, time_next, last_segment && i + 1 == n);
+            }
+            tau = seg_end;
+            continue;
+        }
+
+        // Géométrique / adaptatif : pas coupé sur la fin du segment
+        // (sans pas résiduel minuscule : moins de 10 % du pas est absorbé)
+        while (true) {
+            bool seg_done = (seg_end - tau - h < 0.1 * h);
+            double h_step = seg_done ? seg_end - tau : h;
+            double time_next = seg_done ? seg_end : tau + h;
+            double change = step(h_step, time_next, last_segment && seg_done);
+            if (seg_done) break;
+            h = nextStep(h, change);
+        }
+    }
+}
+
+// Conditions aux limites (Dirichlet Dynamique) à l'instant time_next
+// On utilise l'approximation : V(Boundary) approx Payoff(Boundary) * Discount
+// Cela fonctionne pour Call et Put sans "if" explicite sur le type de contrat.
+// Les payoffs aux bornes ne dépendent pas du temps : ils sont évalués une fois par l'appelant.
+void PDESolver::boundaryValues(double payoff_low, double payoff_high, double time_next,
+                               double& V_left, double& V_right) const {
+    double discount = std::exp(-discountExponent(time_next));
+
+    // Limite Gauche (S -> 0)
+    V_left = payoff_low * discount;
+
+    // Limite Droite (S -> S_max)
+    // Pour un Call, V ~ S - K*exp(-rt). Pour un Put, V ~ 0.
+    // Si c'est un Call, payoff(S_max) = S_max - K.
+    // La valeur actuelle est S_max - K * exp(-rt).
+    // On reconstitue K implicite : K_approx = S_max - payoff(S_max).
+    double S_high = prepared->S[N-1];
+    // Si payoff_high est proche de 0 (Put OTM), c'est 0.
+    // Si payoff_high est grand (Call ITM), on ajuste le strike.
+    if (payoff_high > S_high * 0.1) { 
+         double K_implied = S_high - payoff_high;
+         V_right = S_high - K_implied * discount;
+    } else {
+         V_right = payoff_high * discount;
+    }
+}
+
+// Dérivées par rapport à r des valeurs de Dirichlet (bornes de l'équation tangente du Rho)
+void PDESolver::boundaryRhoValues(double payoff_low, double payoff_high, double time_next,
+                                  double& dV_left, double& dV_right) const {
+    double discount = std::exp(-discountExponent(time_next));
+
+    dV_left = -time_next * payoff_low * discount;
+
+    double S_high = prepared->S[N-1];
+    if (payoff_high > S_high * 0.1) {
+         double K_implied = S_high - payoff_high;
+         dV_right = time_next * K_implied * discount;
+    } else {
+         dV_right = -time_next * payoff_high * discount;
     }
 }
 
 PricingResults PDESolver::solve(const Payoff& payoff, double S0) {
     // 1. Préparation
+    phase_clock.restart();
     precomputeMatrices();
+    phase_clock.lap(SolvePhase::Operator);
 
-    // Reconstruction de la grille pour les calculs de conditions aux limites
-    double x_min = std::log(S_max / 3000.0);
-    
-    
-    std::vector<double> x(N);
-    std::vector<double> S(N); // On stocke aussi S pour éviter exp() répétés
-    std::vector<double> V(N); 
+    // 2. Condition Terminale (Payoff à t=T) sur la grille précalculée
+    payoff.evaluate(prepared->S, V);
+    phase_clock.lap(SolvePhase::Payoff);
 
-    // 2. Condition Terminale (Payoff à t=T)
+    march();
+
+    // 4. Interpolation et calcul des Grecques
+    PricingResults result = slice.evaluate(S0, Interpolation::Linear);
+    phase_clock.lap(SolvePhase::Interpolation);
+    finishStats(1);
+    return result;
+}
+
+SolutionSlice PDESolver::solveSlice(const Payoff& payoff) {
+    phase_clock.restart();
+    precomputeMatrices();
+    phase_clock.lap(SolvePhase::Operator);
+    payoff.evaluate(prepared->S, V);
+    phase_clock.lap(SolvePhase::Payoff);
+    march();
+    finishStats(1);
+    return slice;
+}
+
+PricingResults PDESolver::solveControlVariate(bool is_call, double K, double S0) {
+    if (exercise_style == ExerciseStyle::American) {
+        throw std::logic_error("Erreur PDESolver: Variable de controle reservee a l'exercice europeen.");
+    }
+    if (compute_sensitivities) {
+        throw std::logic_error("Erreur PDESolver: Variable de controle incompatible avec les sensibilites tangentes.");
+    }
+    if (!(K > 0.0)) {
+        throw std::invalid_argument("Erreur PDESolver: Strike non positif.");
+    }
+
+    phase_clock.restart();
+    precomputeMatrices();
+    phase_clock.lap(SolvePhase::Operator);
+
+    // Faces des cellules (milieux en ln S), recalculées seulement si la grille change
+    const std::vector<double>& S = prepared->S;
+    if (cv_grid != prepared) {
+        const std::vector<double>& x = prepared->grid.nodes();
+        cv_x.resize(N - 1);
+        cv_S.resize(N - 1);
+        cv_price.resize(N - 1);
+        cv_delta.resize(N - 1);
+        cv_source.resize(N - 2);
+        for (size_t f = 0; f + 1 < N; ++f) {
+            cv_x[f] = 0.5 * (x[f] + x[f + 1]);
+            cv_S[f] = std::exp(cv_x[f]);
+        }
+        cv_grid = prepared;
+    }
+    phase_clock.lap(SolvePhase::Grid);
+
+    // Payoff sur la grille : march() en lit les bornes avant de partir de E = 0
     for (size_t i = 0; i < N; ++i) {
-        x[i] = x_min + i * dx;
-        S[i] = std::exp(x[i]);
-        V[i] = payoff(S[i]); 
-    }
-
-    std::vector<double> d(N - 2);     // Second membre du système linéaire
-    std::vector<double> V_solve(N - 2); // Vecteur résultat du solveur linéaire
-
-    // 3. Boucle Temporelle (Backward)
-    for (size_t t = 0; t < M; ++t) {
-        // Temps restant jusqu'à maturité pour la prochaine étape (t+1)
-        double time_next = (t + 1) * dt;
-
-        // --- CONDITIONS AUX LIMITES (Dirichlet Dynamique) ---
-        // On utilise l'approximation : V(Boundary) approx Payoff(Boundary) * Discount
-        // Cela fonctionne pour Call et Put sans "if" explicite.
-        // Pour être plus précis sur un Call (S -> infini), V ~ S (pas d'escompte sur S).
-        
-        
-        // Limite Gauche (S -> 0)
-        double S_low = S[0];
-        double V_boundary_left = payoff(S_low) * std::exp(-r * time_next);
-
-        // Limite Droite (S -> S_max)
-        // Pour un Call, V ~ S - K*exp(-rt). Pour un Put, V ~ 0.
-        // On utilise le Payoff pour détecter la valeur intrinsèque.
-        // Si c'est un Call, payoff(S_max) = S_max - K.
-        // La valeur actuelle est S_max - K * exp(-rt).
-        // On reconstitue K implicite : K_approx = S_max - payoff(S_max).
-        double S_high = S[N-1];
-        double val_intrinsic = payoff(S_high);
-        // Si val_intrinsic est proche de 0 (Put OTM), c'est 0.
-        // Si val_intrinsic est grand (Call ITM), on ajuste le strike.
-        double V_boundary_right = 0.0;
-        
-        if (val_intrinsic > S_high * 0.1) { 
-             double K_implied = S_high - val_intrinsic;
-             V_boundary_right = S_high - K_implied * std::exp(-r * time_next);
+        V[i] = is_call ? std::max(S[i] - K, 0.0) : std::max(K - S[i], 0.0);
+    }
+    phase_clock.lap(SolvePhase::Payoff);
+
+    cv_active = true;
+    cv_is_call = is_call;
+    cv_K = K;
+    try {
+        march();
+    } catch (...) {
+        cv_active = false;
+        throw;
+    }
+    cv_active = false;
+
+    // Écart interpolé au spot + forme fermée de la référence
+    PricingResults result = slice.evaluate(S0, Interpolation::Linear);
+    PricingResults bs = blackScholesGreeks(is_call, S0, K, T, r, sigma);
+    result.price += bs.price;
+    result.delta += bs.delta;
+    result.gamma += bs.gamma;
+    result.theta += bs.theta;
+    phase_clock.lap(SolvePhase::Interpolation);
+    finishStats(1);
+    return result;
+}
+
+// Source (L - L_BS) V_BS de l'équation de l'écart au temps restant tau.
+// En ln S, avec V_x = S Delta :
+//   0.5 (sigma^2 - sigma_BS^2) d/dx (V_x - V) + (r - r_BS) (V_x - V).
+// Moyennée sur la cellule [x_{j-1/2}, x_{j+1/2}] du noeud j, la dérivée devient une
+// différence aux faces : pas de Gamma ponctuel, singulier près de la maturité.
+// Renvoie false si la source est nulle (coefficients du pas égaux à la référence).
+bool PDESolver::controlVariateSource(double tau) {
+    if (!local_vol && cur_r == r && cur_sigma == sigma) {
+        return false;
+    }
+    blackScholesAtSpots(cv_is_call, cv_S.data(), cv_x.data(), N - 1, cv_K, tau, r, sigma,
+                        cv_price.data(), cv_delta.data());
+
+    const double var_ref = sigma * sigma;
+    const double dr = cur_r - r;
+    for (size_t j = 1; j + 1 < N; ++j) {
+        const double h = cv_x[j] - cv_x[j - 1];
+        const double g_left  = cv_S[j - 1] * cv_delta[j - 1] - cv_price[j - 1]; // V_x - V aux faces
+        const double g_right = cv_S[j] * cv_delta[j] - cv_price[j];
+        const double s = local_vol ? lv_sigma[j] : cur_sigma;
+        cv_source[j - 1] = 0.5 * (s * s - var_ref) * (g_right - g_left) / h
+                         + dr * ((cv_price[j] - cv_price[j - 1]) / h - 0.5 * (cv_price[j - 1] + cv_price[j]));
+    }
+    return true;
+}
+
+// Clôture des statistiques du solve courant (sans effet si EDP_ENABLE_STATS vaut 0)
+void PDESolver::finishStats(size_t contracts) {
+    if constexpr (SolveStats::enabled) {
+        stats.solves = 1;
+        stats.node_steps = stats.steps * N * contracts;
+        stats.factorizations = factorizations - factorizations_mark;
+        factorizations_mark = factorizations;
+
+        // Espaces de travail dont la capacité a changé depuis le solve précédent
+        const std::vector<double>* buffers[] = {
+            &V, &V_prev, &d, &V_solve, &U_sigma, &U_r, &d_sigma, &d_r,
+            &V_batch, &V_batch_prev, &d_batch, &V_batch_solve, &payoff_values, &payoff_bounds, &V_bounds,
+            &obstacle, &lv_sigma, &lv_sample, &cv_x, &cv_S, &cv_price, &cv_delta, &cv_source};
+        const std::vector<float>* float_buffers[] = {&Vf_batch, &Vf_next, &Ef_batch, &df_batch};
+        const size_t n_double = sizeof(buffers) / sizeof(buffers[0]);
+        workspace_capacity.resize(n_double + sizeof(float_buffers) / sizeof(float_buffers[0]), 0);
+        auto track = [&](size_t slot, size_t capacity) {
+            if (capacity != workspace_capacity[slot]) {
+                ++stats.allocations;
+                workspace_capacity[slot] = capacity;
+            }
+        };
+        for (size_t j = 0; j < n_double; ++j) track(j, buffers[j]->capacity());
+        for (size_t j = 0; j < workspace_capacity.size() - n_double; ++j) {
+            track(n_double + j, float_buffers[j]->capacity());
+        }
+
+        last_stats = stats;
+        total_stats += stats;
+        stats = SolveStats();
+    } else {
+        (void)contracts;
+    }
+}
+
+void PDESolver::setExerciseStyle(ExerciseStyle style, AmericanMethod method) {
+    exercise_style = style;
+    american_method = method;
+}
+
+// Obstacle (payoff aux noeuds intérieurs) et choix de la méthode de projection.
+// Brennan-Schwartz suppose une seule région d'exercice collée à une borne :
+// c'est le cas d'un payoff monotone (put : bas, call : haut). Sinon, PSOR.
+void PDESolver::prepareExercise() {
+    obstacle.assign(V.begin() + 1, V.end() - 1);
+    exercise_boundary.clear();
+
+    bool non_increasing = true, non_decreasing = true;
+    for (size_t i = 1; i < N; ++i) {
+        if (V[i] > V[i-1]) non_increasing = false;
+        if (V[i] < V[i-1]) non_decreasing = false;
+    }
+    bool monotone = non_increasing || non_decreasing;
+    exercise_side = (V[0] >= V[N-1]) ? ExerciseSide::Low : ExerciseSide::High;
+
+    switch (american_method) {
+        case AmericanMethod::Auto:
+            use_psor = !monotone;
+            break;
+        case AmericanMethod::BrennanSchwartz:
+            if (!monotone) {
+                throw std::invalid_argument("Erreur PDESolver: Brennan-Schwartz requiert un payoff monotone.");
+            }
+            use_psor = false;
+            break;
+        case AmericanMethod::PSOR:
+            use_psor = true;
+            break;
+    }
+}
+
+// Résolution projetée A V = d, V >= obstacle (second membre dans d, résultat dans V_solve)
+void PDESolver::solveExercise() {
+    if (use_psor) {
+        // Point de départ : la tranche précédente
+        std::copy(V.begin() + 1, V.end() - 1, V_solve.begin());
+        projectedSOR(op->A_lower, op->A_diag, op->A_upper, d, obstacle, V_solve);
+    } else {
+        brennanSchwartz(op->A_lower, op->A_diag, op->A_upper, d, obstacle, V_solve, exercise_ws, exercise_side);
+    }
+}
+
+// Frontière d'exercice : dernier noeud exercé depuis la borne du côté de l'exercice
+void PDESolver::recordExerciseBoundary(double time_next) {
+    double S_star = 0.0;
+    if (exercise_side == ExerciseSide::Low) {
+        for (size_t i = 0; i < N - 2 && V[i+1] <= obstacle[i] && obstacle[i] > 0.0; ++i) {
+            S_star = prepared->S[i+1];
+        }
+    } else {
+        for (size_t i = N - 3; i != static_cast<size_t>(-1) && V[i+1] <= obstacle[i] && obstacle[i] > 0.0; --i) {
+            S_star = prepared->S[i+1];
+        }
+    }
+    exercise_boundary.push_back({time_next, S_star});
+}
+
+void PDESolver::march() {
+    // Payoffs aux bornes, lus sur la condition terminale
+    double payoff_low  = V[0];
+    double payoff_high = V[N-1];
+
+    // Variable de contrôle : on propage l'écart au prix de Black-Scholes, nul à maturité
+    if (cv_active) {
+        std::fill(V.begin(), V.end(), 0.0);
+    }
+
+    // Sensibilités tangentes : U = dV/dp est nul à maturité (payoff indépendant de sigma et r)
+    if (compute_sensitivities) {
+        std::fill(U_sigma.begin(), U_sigma.end(), 0.0);
+        std::fill(U_r.begin(), U_r.end(), 0.0);
+    }
+
+    // Résolution A y = rhs (descente/remontée seules, A déjà factorisée)
+    auto solveA = [this](const std::vector<double>& rhs, std::vector<double>& y) {
+        if (use_parallel) {
+            A_parallel.apply(rhs, y);
+        } else {
+            op->A_factor.apply(rhs, y);
+        }
+    };
+
+    const bool adaptive = (time_stepping == TimeStepping::Adaptive);
+    const bool american = (exercise_style == ExerciseStyle::American);
+    if (american) {
+        prepareExercise();
+    }
+    phase_clock.lap(SolvePhase::Payoff);
+
+    // 3. Boucle Temporelle (Backward), un pas 'step' au schéma 'theta'
+    auto advance = [&](double step, double theta, double time_next, bool last) {
+        prepareOperator(step, theta);
+        phase_clock.lap(SolvePhase::Operator);
+        const double theta_explicit = 1.0 - theta;
+
+        // Avant-dernière tranche conservée pour le Theta
+        if (last) {
+            V_prev = V;
+            last_dt = step;
+        }
+
+        // --- CONDITIONS AUX LIMITES ---
+        double V_boundary_left, V_boundary_right;
+        if (cv_active) {
+            // Écart des asymptotes : seule l'actualisation du strike diffère de la référence
+            // (put : K e^{-int r} - S à gauche ; call : S - K e^{-int r} à droite)
+            double gap = cv_K * (std::exp(-r * time_next) - std::exp(-discountExponent(time_next)));
+            V_boundary_left  = cv_is_call ? 0.0 : -gap;
+            V_boundary_right = cv_is_call ? gap : 0.0;
         } else {
-             
-             V_boundary_right = val_intrinsic * std::exp(-r * time_next);
+            boundaryValues(payoff_low, payoff_high, time_next, V_boundary_left, V_boundary_right);
+        }
+
+        // Américaine : la valeur aux bornes ne descend pas sous la valeur d'exercice
+        bool exercised_left = false, exercised_right = false;
+        if (american) {
+            exercised_left  = (V_boundary_left <= payoff_low);
+            exercised_right = (V_boundary_right <= payoff_high);
+            V_boundary_left  = std::max(V_boundary_left, payoff_low);
+            V_boundary_right = std::max(V_boundary_right, payoff_high);
         }
+        phase_clock.lap(SolvePhase::Boundary);
 
         // --- Construction du second membre d (Partie Explicite) ---
         for (size_t i = 0; i < N - 2; ++i) {
-            d[i] = B_lower[i] * V[i] + B_diag[i] * V[i+1] + B_upper[i] * V[i+2];
+            d[i] = op->B_lower[i] * V[i] + op->B_diag[i] * V[i+1] + op->B_upper[i] * V[i+2];
+        }
+        // Source de la variable de contrôle, prise au milieu du pas
+        if (cv_active && controlVariateSource(time_next - 0.5 * step)) {
+            for (size_t i = 0; i < N - 2; ++i) {
+                d[i] += step * cv_source[i];
+            }
+        }
+        phase_clock.lap(SolvePhase::Rhs);
+
+        // Seconds membres tangents, partie explicite :
+        // B U^n + (1 - theta) dt (dL/dp) V^n
+        if (compute_sensitivities) {
+            for (size_t i = 0; i < N - 2; ++i) {
+                d_sigma[i] = op->B_lower[i] * U_sigma[i] + op->B_diag[i] * U_sigma[i+1] + op->B_upper[i] * U_sigma[i+2]
+                           + theta_explicit * (op->dLs_lower[i] * V[i] + op->dLs_diag[i] * V[i+1] + op->dLs_upper[i] * V[i+2]);
+                d_r[i]     = op->B_lower[i] * U_r[i] + op->B_diag[i] * U_r[i+1] + op->B_upper[i] * U_r[i+2]
+                           + theta_explicit * (op->dLr_lower[i] * V[i] + op->dLr_diag[i] * V[i+1] + op->dLr_upper[i] * V[i+2]);
+            }
+            phase_clock.lap(SolvePhase::Sensitivities);
         }
 
         // Injection des conditions aux limites
-        d[0]     -= A_lower[0] * V_boundary_left;
-        d[N-3]   -= A_upper[N-3] * V_boundary_right;
+        d[0]     -= op->A_lower[0] * V_boundary_left;
+        d[N-3]   -= op->A_upper[N-3] * V_boundary_right;
 
-        // Résolution
-        thomasAlgorithm(A_lower, A_diag, A_upper, d, V_solve);
+        if (american) {
+            solveExercise();
+        } else {
+            solveA(d, V_solve);
+        }
+        phase_clock.lap(SolvePhase::LinearSolve);
 
         // Mise à jour de la solution globale
+        // (adaptatif : variation relative max |V^{n+1} - V^n| / max(1, |V^{n+1}|, |V^n|))
+        double change = 0.0;
+        if (adaptive) {
+            for (size_t i = 0; i < N - 2; ++i) {
+                double scale = std::max(1.0, std::max(std::fabs(V_solve[i]), std::fabs(V[i+1])));
+                change = std::max(change, std::fabs(V_solve[i] - V[i+1]) / scale);
+            }
+        }
         for (size_t i = 0; i < N - 2; ++i) {
             V[i+1] = V_solve[i];
         }
         V[0]   = V_boundary_left;
         V[N-1] = V_boundary_right;
+
+        if (american) {
+            recordExerciseBoundary(time_next);
+        }
+        phase_clock.lap(SolvePhase::Update);
+
+        // --- ÉQUATIONS TANGENTES (Vega, Rho) ---
+        // Dérivée du schéma A V^{n+1} = B V^n par rapport à p :
+        // A U^{n+1} = B U^n + dt (dL/dp) [(1 - theta) V^n + theta V^{n+1}]
+        // Même matrice A : seuls deux seconds membres de plus par pas.
+        if (compute_sensitivities) {
+            for (size_t i = 0; i < N - 2; ++i) {
+                d_sigma[i] += theta * (op->dLs_lower[i] * V[i] + op->dLs_diag[i] * V[i+1] + op->dLs_upper[i] * V[i+2]);
+                d_r[i]     += theta * (op->dLr_lower[i] * V[i] + op->dLr_diag[i] * V[i+1] + op->dLr_upper[i] * V[i+2]);
+            }
+
+            // Bornes : Dirichlet indépendant de sigma ; dérivée de l'actualisation pour r
+            double dr_left, dr_right;
+            boundaryRhoValues(payoff_low, payoff_high, time_next, dr_left, dr_right);
+            if (exercised_left)  dr_left = 0.0;
+            if (exercised_right) dr_right = 0.0;
+            d_r[0]   -= op->A_lower[0] * dr_left;
+            d_r[N-3] -= op->A_upper[N-3] * dr_right;
+
+            solveA(d_sigma, V_solve);
+            for (size_t i = 0; i < N - 2; ++i) {
+                U_sigma[i+1] = V_solve[i];
+            }
+
+            solveA(d_r, V_solve);
+            for (size_t i = 0; i < N - 2; ++i) {
+                U_r[i+1] = V_solve[i];
+            }
+            U_r[0]   = dr_left;
+            U_r[N-1] = dr_right;
+
+            // Région d'exercice : V = payoff, indépendant de sigma et r
+            if (american) {
+                for (size_t i = 0; i < N - 2; ++i) {
+                    if (V[i+1] <= obstacle[i]) {
+                        U_sigma[i+1] = 0.0;
+                        U_r[i+1] = 0.0;
+                    }
+                }
+            }
+            phase_clock.lap(SolvePhase::Sensitivities);
+        }
+        return change;
+    };
+
+    timeLoop(advance);
+
+    slice.assign(prepared->grid, V);
+
+    // Theta = dV/dt (temps calendaire) entre les deux dernières tranches
+    if (steps_taken > 0) {
+        for (size_t i = 0; i < N; ++i) {
+            V_prev[i] = (V_prev[i] - V[i]) / last_dt;
+        }
+        slice.assignTheta(V_prev);
+    }
+    if (compute_sensitivities) {
+        slice.assignVega(U_sigma);
+        slice.assignRho(U_r);
     }
+    phase_clock.lap(SolvePhase::Interpolation);
+}
 
-    // 4. Interpolation et calcul des Grecques
-    double target_x = std::log(S0);
-    
-    // Recherche dichotomique ou linéaire de l'indice
-    // On s'assure de ne pas sortir des bornes pour le calcul de Gamma (i >= 1)
-    size_t i = 1; 
-    while (i < N - 2 && x[i+1] < target_x) {
-        i++;
+std::vector<PricingResults> PDESolver::solve(const std::vector<const Payoff*>& payoffs,
+                                             const std::vector<double>& spots) {
+    size_t K = payoffs.size();
+
+    if (spots.size() != K) {
+        throw std::invalid_argument("Erreur PDESolver: Un spot par payoff est attendu.");
     }
+    if (K == 0) {
+        return {};
+    }
+
+    // Américaines : la projection se fait contrat par contrat
+    phase_clock.restart();
+    if (exercise_style == ExerciseStyle::American) {
+        std::vector<PricingResults> results(K);
+        for (size_t k = 0; k < K; ++k) {
+            precomputeMatrices();
+            phase_clock.lap(SolvePhase::Operator);
+            payoffs[k]->evaluate(prepared->S, V);
+            march();
+            results[k] = slice.evaluate(spots[k], Interpolation::Linear);
+            phase_clock.lap(SolvePhase::Interpolation);
+        }
+        finishStats(1);
+        return results;
+    }
+
+    marchBatch(payoffs);
 
-    // A. Interpolation du PRIX
-    double ratio = (target_x - x[i]) / dx;
-    double price = V[i] * (1.0 - ratio) + V[i+1] * ratio;
+    // 4. Interpolation et calcul des Grecques, contrat par contrat
+    std::vector<PricingResults> results(K);
+    for (size_t k = 0; k < K; ++k) {
+        loadBatchSlice(k, K);
+        results[k] = slice.evaluate(spots[k], Interpolation::Linear);
+    }
+    phase_clock.lap(SolvePhase::Interpolation);
+    finishStats(K);
+    return results;
+}
+
+void PDESolver::solveSlices(const std::vector<const Payoff*>& payoffs, std::vector<SolutionSlice>& out) {
+    const size_t K = payoffs.size();
+    out.resize(K);
+    if (K == 0) {
+        return;
+    }
+
+    phase_clock.restart();
+    if (exercise_style == ExerciseStyle::American) {
+        for (size_t k = 0; k < K; ++k) {
+            precomputeMatrices();
+            phase_clock.lap(SolvePhase::Operator);
+            payoffs[k]->evaluate(prepared->S, V);
+            march();
+            out[k] = slice;
+        }
+        finishStats(1);
+        return;
+    }
+
+    marchBatch(payoffs);
+    for (size_t k = 0; k < K; ++k) {
+        loadBatchSlice(k, K);
+        out[k] = slice;
+    }
+    phase_clock.lap(SolvePhase::Interpolation);
+    finishStats(K);
+}
 
-    // B. Calcul du DELTA et GAMMA (Différences finies sur la grille log)
-    // Chain rule : dV/dS = (dV/dx) * (1/S)
-    double dV_dx = (V[i+1] - V[i-1]) / (2.0 * dx); // Différence centrée meilleure
-    double delta = dV_dx / S[i];
+// Tranche t = 0 (et Theta) du contrat k du lot, chargée dans 'slice'
+void PDESolver::loadBatchSlice(size_t k, size_t K) {
+    for (size_t i = 0; i < N; ++i) {
+        payoff_values[i] = V_batch[i * K + k];
+    }
+    slice.assign(prepared->grid, payoff_values);
+    if (steps_taken > 0) {
+        for (size_t i = 0; i < N; ++i) {
+            V_prev[i] = (V_batch_prev[i * K + k] - V_batch[i * K + k]) / last_dt;
+        }
+        slice.assignTheta(V_prev);
+    }
+}
+
+// Remontée en temps de tout le lot (européen) : solution à t = 0 dans V_batch,
+// avant-dernière tranche dans V_batch_prev
+void PDESolver::marchBatch(const std::vector<const Payoff*>& payoffs) {
+    const size_t K = payoffs.size();
+
+    // 1. Préparation : une seule grille, une seule factorisation pour tout le lot
+    precomputeMatrices();
+    phase_clock.lap(SolvePhase::Operator);
+
+    // Espaces de travail entrelacés : élément (i, k) rangé en i * K + k
+    // (réalloués uniquement si la taille du lot change)
+    V_batch.resize(N * K);
+    d_batch.resize((N - 2) * K);
+    V_batch_solve.resize((N - 2) * K);
+    payoff_bounds.resize(2 * K);
+    V_bounds.resize(2 * K);
+
+    // 2. Conditions Terminales (évaluation groupée, un appel virtuel par contrat)
+    for (size_t k = 0; k < K; ++k) {
+        payoffs[k]->evaluate(prepared->S, payoff_values);
+        for (size_t i = 0; i < N; ++i) {
+            V_batch[i * K + k] = payoff_values[i];
+        }
+    }
+    for (size_t k = 0; k < K; ++k) {
+        payoff_bounds[k]     = V_batch[k];
+        payoff_bounds[K + k] = V_batch[(N - 1) * K + k];
+    }
+
+    const bool adaptive = (time_stepping == TimeStepping::Adaptive);
+
+    // Précision réduite : état float (et correction nulle à maturité)
+    const bool reduced = (precision != Precision::Double);
+    if (reduced) {
+        Vf_batch.assign(V_batch.begin(), V_batch.end());
+        Vf_next.resize(N * K);
+        df_batch.resize((N - 2) * K);
+        if (precision == Precision::Mixed) {
+            Ef_batch.assign(N * K, 0.0f);
+        }
+    }
+    phase_clock.lap(SolvePhase::Payoff);
+
+    // 3. Boucle Temporelle (Backward), tous les contrats ensemble
+    auto advance = [&](double step, double theta, double time_next, bool last) {
+        prepareOperator(step, theta);
+        phase_clock.lap(SolvePhase::Operator);
+
+        // Avant-dernière tranche conservée pour le Theta
+        if (last) {
+            if (reduced) materializeBatch(K);
+            V_batch_prev = V_batch;
+            last_dt = step;
+        }
 
-    // Gamma = (d2V/dS2) = (d2V/dx2 - dV/dx) / S^2
-    double d2V_dx2 = (V[i+1] - 2.0 * V[i] + V[i-1]) / (dx * dx);
-    double gamma = (d2V_dx2 - dV_dx) / (S[i] * S[i]);
+        // --- CONDITIONS AUX LIMITES (par contrat) ---
+        for (size_t k = 0; k < K; ++k) {
+            boundaryValues(payoff_bounds[k], payoff_bounds[K + k], time_next,
+                           V_bounds[k], V_bounds[K + k]);
+        }
+        phase_clock.lap(SolvePhase::Boundary);
+
+        if (reduced) {
+            double change = advanceBatchReduced(K, adaptive);
+            phase_clock.lap(SolvePhase::LinearSolve);
+            return change;
+        }
+
+        // --- Second membre : boucle interne sur les contrats (pas unitaire) ---
+        for (size_t i = 0; i < N - 2; ++i) {
+            const double bl = op->B_lower[i], bd = op->B_diag[i], bu = op->B_upper[i];
+            const double* V0 = &V_batch[i * K];
+            const double* V1 = V0 + K;
+            const double* V2 = V1 + K;
+            double* di = &d_batch[i * K];
+            for (size_t k = 0; k < K; ++k) {
+                di[k] = bl * V0[k] + bd * V1[k] + bu * V2[k];
+            }
+        }
+        phase_clock.lap(SolvePhase::Rhs);
+
+        // Injection des conditions aux limites
+        for (size_t k = 0; k < K; ++k) {
+            d_batch[k]               -= op->A_lower[0] * V_bounds[k];
+            d_batch[(N - 3) * K + k] -= op->A_upper[N-3] * V_bounds[K + k];
+        }
+
+        // Résolution multi-seconds membres avec la même factorisation
+        op->A_factor.applyInterleaved(d_batch, V_batch_solve, K);
+        phase_clock.lap(SolvePhase::LinearSolve);
+
+        // Variation relative max sur tout le lot (mode adaptatif : pas commun)
+        double change = 0.0;
+        if (adaptive) {
+            for (size_t j = 0; j < (N - 2) * K; ++j) {
+                double v_old = V_batch[K + j], v_new = V_batch_solve[j];
+                double scale = std::max(1.0, std::max(std::fabs(v_new), std::fabs(v_old)));
+                change = std::max(change, std::fabs(v_new - v_old) / scale);
+            }
+        }
+
+        // Mise à jour de la solution globale
+        std::copy(V_batch_solve.begin(), V_batch_solve.end(), V_batch.begin() + K);
+        for (size_t k = 0; k < K; ++k) {
+            V_batch[k]               = V_bounds[k];
+            V_batch[(N - 1) * K + k] = V_bounds[K + k];
+        }
+        phase_clock.lap(SolvePhase::Update);
+        return change;
+    };
+
+    timeLoop(advance);
+    if (reduced) {
+        materializeBatch(K);
+    }
+}
+
+// Copie float de l'opérateur courant, factorisée en float
+void PDESolver::refreshFloatOperator() {
+    Af_lower.assign(op->A_lower.begin(), op->A_lower.end());
+    Af_diag.assign(op->A_diag.begin(), op->A_diag.end());
+    Af_upper.assign(op->A_upper.begin(), op->A_upper.end());
+    Bf_lower.assign(op->B_lower.begin(), op->B_lower.end());
+    Bf_diag.assign(op->B_diag.begin(), op->B_diag.end());
+    Bf_upper.assign(op->B_upper.begin(), op->B_upper.end());
+    A_factor_f.factorize(Af_lower, Af_diag, Af_upper);
+    float_op_stale = false;
+}
+
+// Solution double du lot : V = Vf (+ E en mode Mixed)
+void PDESolver::materializeBatch(size_t K) {
+    V_batch.resize(N * K);
+    if (precision == Precision::Mixed) {
+        for (size_t j = 0; j < N * K; ++j) {
+            V_batch[j] = static_cast<double>(Vf_batch[j]) + static_cast<double>(Ef_batch[j]);
+        }
+    } else {
+        for (size_t j = 0; j < N * K; ++j) {
+            V_batch[j] = static_cast<double>(Vf_batch[j]);
+        }
+    }
+}
+
+// Un pas du lot en précision réduite (bornes V_bounds déjà calculées).
+// Float : Vf^{n+1} = Af^{-1} (Bf Vf^n - bornes), tout en float.
+// Mixed : en plus, défaut du pas float vis-à-vis du schéma double,
+//   delta = B Vf^n - A Vf^{n+1} (lignes complètes, en double),
+// puis équation de l'erreur E résolue en float : Af E^{n+1} = Bf E^n + delta.
+// E ne porte que les erreurs d'arrondi : son propre arrondi float (relatif à E) reste petit.
+double PDESolver::advanceBatchReduced(size_t K, bool adaptive) {
+    if (float_op_stale) {
+        refreshFloatOperator();
+    }
+    const size_t n = N - 2;
+
+    // --- Pas float ---
+    for (size_t i = 0; i < n; ++i) {
+        const float bl = Bf_lower[i], bd = Bf_diag[i], bu = Bf_upper[i];
+        const float* V0 = &Vf_batch[i * K];
+        const float* V1 = V0 + K;
+        const float* V2 = V1 + K;
+        float* di = &df_batch[i * K];
+        for (size_t k = 0; k < K; ++k) {
+            di[k] = bl * V0[k] + bd * V1[k] + bu * V2[k];
+        }
+    }
+    for (size_t k = 0; k < K; ++k) {
+        Vf_next[k]               = static_cast<float>(V_bounds[k]);
+        Vf_next[(N - 1) * K + k] = static_cast<float>(V_bounds[K + k]);
+        df_batch[k]              -= Af_lower[0] * Vf_next[k];
+        df_batch[(n - 1) * K + k] -= Af_upper[n - 1] * Vf_next[(N - 1) * K + k];
+    }
+    A_factor_f.applyInterleaved(df_batch, df_batch, K);
+    float* next = Vf_next.data() + K;
+    for (size_t j = 0; j < n * K; ++j) {
+        const float v = df_batch[j];
+        next[j] = (std::fabs(v) < kFloatFlushThreshold) ? 0.0f : v;
+    }
+
+    double change = 0.0;
+    if (adaptive) {
+        for (size_t j = K; j < (N - 1) * K; ++j) {
+            double v_old = Vf_batch[j], v_new = Vf_next[j];
+            double scale = std::max(1.0, std::max(std::fabs(v_new), std::fabs(v_old)));
+            change = std::max(change, std::fabs(v_new - v_old) / scale);
+        }
+    }
+
+    // --- Correction de défaut (Mixed) ---
+    if (precision == Precision::Mixed) {
+        for (size_t i = 0; i < n; ++i) {
+            const double bl = op->B_lower[i], bd = op->B_diag[i], bu = op->B_upper[i];
+            const double al = op->A_lower[i], ad = op->A_diag[i], au = op->A_upper[i];
+            const float fl = Bf_lower[i], fd = Bf_diag[i], fu = Bf_upper[i];
+            const float* V0 = &Vf_batch[i * K];
+            const float* X0 = &Vf_next[i * K];
+            const float* E0 = &Ef_batch[i * K];
+            float* di = &df_batch[i * K];
+            for (size_t k = 0; k < K; ++k) {
+                double defect = bl * V0[k] + bd * V0[K + k] + bu * V0[2 * K + k]
+                              - (al * X0[k] + ad * X0[K + k] + au * X0[2 * K + k]);
+                di[k] = fl * E0[k] + fd * E0[K + k] + fu * E0[2 * K + k] + static_cast<float>(defect);
+            }
+        }
+        // Erreur aux bornes : arrondi float des valeurs de Dirichlet
+        for (size_t k = 0; k < K; ++k) {
+            float e_low  = static_cast<float>(V_bounds[k] - static_cast<double>(Vf_next[k]));
+            float e_high = static_cast<float>(V_bounds[K + k] - static_cast<double>(Vf_next[(N - 1) * K + k]));
+            Ef_batch[k] = e_low;
+            Ef_batch[(N - 1) * K + k] = e_high;
+            df_batch[k]               -= Af_lower[0] * e_low;
+            df_batch[(n - 1) * K + k] -= Af_upper[n - 1] * e_high;
+        }
+        A_factor_f.applyInterleaved(df_batch, df_batch, K);
+        // Même seuil que la solution : une erreur sous 1e-30 ne compte dans aucun prix
+        float* error = Ef_batch.data() + K;
+        for (size_t j = 0; j < n * K; ++j) {
+            const float e = df_batch[j];
+            error[j] = (std::fabs(e) < kFloatFlushThreshold) ? 0.0f : e;
+        }
+    }
 
-    // Theta (Temporel) : On pourrait le calculer en stockant V_old, 
-    // mais ici on renvoie 0.0 ou une approx simple
-    return {price, delta, gamma, 0.0};
+    Vf_batch.swap(Vf_next);
+    return change;
 }
 
-} // namespace edp
\ No newline at end of file
+} // namespace edp
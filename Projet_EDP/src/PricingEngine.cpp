@@ -0,0 +1,288 @@
+#include "edp/PricingEngine.h"
+#include "edp/Payoff.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace edp {
+
+namespace {
+
+    // Contrats par paquet dans priceAll : assez pour amortir la file, assez peu pour voler
+    constexpr size_t kChunkSize = 16;
+
+    void validate(const Contract& c) {
+        if (!(c.S0 > 0.0) || !(c.K > 0.0) || !(c.T > 0.0) || !(c.sigma > 0.0)) {
+            throw std::invalid_argument("Erreur PricingEngine: S0, K, T et sigma doivent etre positifs.");
+        }
+    }
+
+} // namespace
+
+GridChoice gridFor(const Contract& c) {
+    if (c.tolerance > 0.0) {
+        GridSizingOptions options;
+        if (c.domain_std > 0.0) options.n_std = c.domain_std;
+        return chooseGrid(c.S0, c.K, c.T, c.r, c.sigma, c.tolerance, options);
+    }
+    if (c.domain_std > 0.0) {
+        GridChoice g = chooseDomain(c.S0, c.K, c.T, c.r, c.sigma, c.N, c.domain_std);
+        g.M = c.M;
+        return g;
+    }
+    GridChoice g;
+    g.S_max = (c.S_max > 0.0) ? c.S_max : 4.0 * c.K;
+    g.S_min = g.S_max / 3000.0;
+    g.N = c.N;
+    g.M = c.M;
+    return g;
+}
+
+PricingEngine::PricingEngine(unsigned nThreads, bool sensitivities_)
+    : sensitivities(sensitivities_) {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    if (nThreads == 0) {
+        nThreads = cores;
+    }
+    // Cœurs restants partagés entre les solveurs des workers (grands N) : pas de
+    // pool de la taille de la machine dans chaque worker
+    solver_threads = std::max(1u, cores / nThreads);
+    workers.reserve(nThreads);
+    for (unsigned t = 0; t < nThreads; ++t) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t]->thread = std::thread([this, t] { workerLoop(t); });
+    }
+}
+
+PricingEngine::~PricingEngine() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        stopping = true;
+    }
+    idle.notify_all();
+    for (auto& w : workers) w->thread.join();
+}
+
+// Même grille uniforme (domaine, N) : même worker
+size_t PricingEngine::affinity(const GridChoice& g) const {
+    size_t h = std::hash<double>()(g.S_max);
+    h ^= std::hash<double>()(g.S_min) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= std::hash<size_t>()(g.N) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h % workers.size();
+}
+
+PricingResults PricingEngine::priceOn(Worker& w, const Contract& c, const GridChoice& g) const {
+    validate(c);
+    if (!(c.S0 < g.S_max)) {
+        throw std::invalid_argument("Erreur PricingEngine: S0 hors de la grille (S0 >= S_max).");
+    }
+
+    if (!w.solver) {
+        w.solver = std::make_unique<PDESolver>(c.T, c.r, c.sigma, g.S_max, c.theta, g.N, g.M);
+        w.solver->setComputeSensitivities(sensitivities);
+        w.solver->setParallelThreshold(w.solver->getParallelThreshold(), solver_threads);
+    }
+    w.solver->reset(c.T, c.r, c.sigma, g.S_max, c.theta, g.N, g.M, g.S_min);
+    w.solver->setRannacherSteps(g.rannacher_steps);
+    if (c.is_call) {
+        return w.solver->solve(PayoffCall(c.K), c.S0);
+    }
+    return w.solver->solve(PayoffPut(c.K), c.S0);
+}
+
+SolveStats PricingEngine::getSolveStats() const {
+    SolveStats total;
+    for (const auto& w : workers) {
+        if (w->solver) total += w->solver->getCumulativeStats();
+    }
+    return total;
+}
+
+// --- Files et vol de tâches ---
+
+// queued est incrémenté sous le verrou de la file, avant que la tâche ne soit visible :
+// un dépilement concurrent ne peut pas le décrémenter en premier (passage sous zéro).
+// Le verrou idle_mutex pris avant notify_all évite de perdre un réveil entre le test
+// du prédicat et la mise en attente d'un worker.
+void PricingEngine::push(size_t worker, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+        ++queued;
+        workers[worker]->tasks.push_back(std::move(task));
+    }
+    { std::lock_guard<std::mutex> lock(idle_mutex); }
+    idle.notify_all();
+}
+
+void PricingEngine::pushMany(size_t worker, std::vector<Task>& batch) {
+    if (batch.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+        queued += batch.size();
+        for (auto& t : batch) workers[worker]->tasks.push_back(std::move(t));
+    }
+    { std::lock_guard<std::mutex> lock(idle_mutex); }
+    batch.clear();
+    idle.notify_all();
+}
+
+// Propre file : par la fin (dernière tâche poussée, la plus chaude)
+bool PricingEngine::popLocal(Worker& w, Task& task) {
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (w.tasks.empty()) return false;
+    task = std::move(w.tasks.back());
+    w.tasks.pop_back();
+    --queued;
+    return true;
+}
+
+// Files des autres workers : par le début (tâches les plus anciennes)
+bool PricingEngine::steal(size_t thief, Task& task) {
+    const size_t n = workers.size();
+    for (size_t k = 1; k < n; ++k) {
+        Worker& victim = *workers[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --queued;
+        ++steals;
+        return true;
+    }
+    return false;
+}
+
+void PricingEngine::workerLoop(size_t index) {
+    Worker& self = *workers[index];
+    Task task;
+    for (;;) {
+        if (popLocal(self, task) || steal(index, task)) {
+            task(self);
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle.wait(lock, [&] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+// --- API ---
+
+std::future<PricingResults> PricingEngine::submit(const Contract& contract) {
+    auto promise = std::make_shared<std::promise<PricingResults>>();
+    std::future<PricingResults> result = promise->get_future();
+    // Grille impossible (domaine automatique invalide...) : erreur portée par le future
+    GridChoice grid;
+    try {
+        grid = gridFor(contract);
+    } catch (...) {
+        promise->set_exception(std::current_exception());
+        return result;
+    }
+    push(affinity(grid), [this, promise, contract, grid](Worker& w) {
+        try {
+            promise->set_value(priceOn(w, contract, grid));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return result;
+}
+
+std::vector<PricingResults> PricingEngine::priceAll(const std::vector<Contract>& contracts) {
+    std::vector<PricingResults> out(contracts.size());
+    priceAll(contracts.data(), contracts.size(), out.data());
+    return out;
+}
+
+void PricingEngine::priceAll(const Contract* contracts, size_t count, PricingResults* out,
+                             std::string* errors, GridChoice* grids) {
+    if (count == 0) return;
+
+    // Grille de chaque contrat, calculée une fois. Grille impossible : erreur du
+    // contrat (errors[i], ou première erreur relancée), contrat retiré du lot
+    std::vector<GridChoice> local_grids;
+    if (!grids) {
+        local_grids.resize(count);
+        grids = local_grids.data();
+    }
+    std::exception_ptr first_error;
+    std::vector<size_t> order;
+    order.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        try {
+            grids[i] = gridFor(contracts[i]);
+            order.push_back(i);
+        } catch (const std::exception& e) {
+            grids[i] = GridChoice();
+            if (errors) {
+                errors[i] = e.what();
+            } else if (!first_error) {
+                first_error = std::current_exception();
+            }
+        }
+    }
+    const size_t valid = order.size();
+
+    // Tri par grille, puis par opérateur (r, sigma, pas, schéma) : paquets homogènes
+    auto key = [&](size_t i) {
+        const Contract& c = contracts[i];
+        const GridChoice& g = grids[i];
+        return std::make_tuple(g.S_max, g.S_min, g.N, c.r, c.sigma, c.T / static_cast<double>(g.M), c.theta);
+    };
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return key(a) < key(b); });
+
+    std::mutex done_mutex;
+    std::condition_variable done;
+    size_t remaining = 0;
+
+    // Paquets consécutifs d'une même grille, poussés dans la file de son worker
+    std::vector<std::vector<Task>> per_worker(workers.size());
+    size_t begin = 0;
+    while (begin < valid) {
+        const GridChoice& head = grids[order[begin]];
+        size_t end = begin + 1;
+        while (end < valid && end - begin < kChunkSize) {
+            const GridChoice& g = grids[order[end]];
+            if (g.S_max != head.S_max || g.S_min != head.S_min || g.N != head.N) break;
+            ++end;
+        }
+
+        ++remaining;
+        per_worker[affinity(head)].push_back([&, begin, end](Worker& w) {
+            for (size_t j = begin; j < end; ++j) {
+                size_t i = order[j];
+                try {
+                    out[i] = priceOn(w, contracts[i], grids[i]);
+                    if (errors) errors[i].clear();
+                } catch (const std::exception& e) {
+                    if (errors) {
+                        errors[i] = e.what();
+                    } else {
+                        std::lock_guard<std::mutex> lock(done_mutex);
+                        if (!first_error) first_error = std::current_exception();
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (--remaining == 0) done.notify_one();
+        });
+        begin = end;
+    }
+
+    // remaining est complet avant la première exécution
+    {
+        std::lock_guard<std::mutex> lock(done_mutex);
+        for (size_t w = 0; w < workers.size(); ++w) pushMany(w, per_worker[w]);
+    }
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done.wait(lock, [&] { return remaining == 0; });
+    if (first_error) std::rethrow_exception(first_error);
+}
+
+} // namespace edp
@@ -0,0 +1,100 @@
+#include "edp/Richardson.h"
+#include "edp/PDESolver.h"
+#include "edp/ThreadPool.h"
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace edp {
+
+namespace {
+
+    // Un niveau de raffinement : grille sinh (N, M), évaluation cubique au spot
+    PricingResults solveLevel(const Payoff& payoff, double S0, double T, double r, double sigma,
+                              double S_max, double theta_scheme, size_t N, size_t M,
+                              const ToleranceOptions& options) {
+        PDESolver solver(T, r, sigma, S_max, theta_scheme, N, M);
+        double center = (options.S_center > 0.0) ? options.S_center : S0;
+        solver.setSinhGrid(center, options.alpha);
+        return solver.solveSlice(payoff).evaluate(S0, Interpolation::Cubic);
+    }
+
+    // Ordre observé sur trois niveaux successifs, borné à [1, 4] (2 si non mesurable)
+    double observedOrder(double p0, double p1, double p2) {
+        double e_coarse = std::fabs(p1 - p0);
+        double e_fine = std::fabs(p2 - p1);
+        if (!(e_coarse > 0.0) || !(e_fine > 0.0)) {
+            return 2.0;
+        }
+        return std::min(4.0, std::max(1.0, std::log2(e_coarse / e_fine)));
+    }
+
+} // namespace
+
+ToleranceResult solveToTolerance(const Payoff& payoff, double S0,
+                                 double T, double r, double sigma,
+                                 double S_max, double theta_scheme,
+                                 double tolerance,
+                                 const ToleranceOptions& options) {
+    if (!(tolerance > 0.0)) {
+        throw std::invalid_argument("Erreur Richardson: Tolerance non positive.");
+    }
+    if (options.max_levels < 3 || options.N0 < 6 || options.M0 < 1) {
+        throw std::invalid_argument("Erreur Richardson: Au moins 3 niveaux et une grille de 6 noeuds.");
+    }
+    // Paramètres vérifiés avant tout solve : aucun niveau ne part sur une entrée invalide
+    if (!(S0 > 0.0) || !(S_max > S0) || !(T > 0.0) || !(sigma > 0.0)) {
+        throw std::invalid_argument("Erreur Richardson: Spot, domaine, maturite ou volatilite invalide.");
+    }
+    if (!(options.alpha > 0.0) || options.S_center < 0.0) {
+        throw std::invalid_argument("Erreur Richardson: Parametres de grille sinh invalides.");
+    }
+
+    auto gridN = [&](size_t l) { return (options.N0 - 1) * (size_t(1) << l) + 1; };
+    auto gridM = [&](size_t l) { return options.M0 * (size_t(1) << l); };
+
+    // 1. Trois premiers niveaux, indépendants : résolus en parallèle si demandé
+    std::vector<PricingResults> levels(3);
+    auto runLevel = [&](size_t l) {
+        levels[l] = solveLevel(payoff, S0, T, r, sigma, S_max, theta_scheme, gridN(l), gridM(l), options);
+    };
+    if (options.parallel) {
+        // Le plus coûteux distribué en premier ; une exception d'un niveau est
+        // relancée ici après la fin des deux autres
+        ThreadPool pool(3);
+        pool.parallelFor(3, 1, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                runLevel(2 - k);
+            }
+        });
+    } else {
+        for (size_t l = 0; l < 3; ++l) {
+            runLevel(l);
+        }
+    }
+
+    // 2. Extrapolation, puis raffinement jusqu'à la tolérance
+    double order = observedOrder(levels[0].price, levels[1].price, levels[2].price);
+    double extrapolated = levels[2].price + (levels[2].price - levels[1].price) / (std::pow(2.0, order) - 1.0);
+    // Sans extrapolation précédente : l'écart au niveau le plus fin majore l'erreur
+    double error = std::fabs(extrapolated - levels[2].price);
+
+    size_t l = 2;
+    while (error > tolerance && l + 1 < options.max_levels) {
+        ++l;
+        levels.push_back(solveLevel(payoff, S0, T, r, sigma, S_max, theta_scheme, gridN(l), gridM(l), options));
+
+        double p0 = levels[l-2].price, p1 = levels[l-1].price, p2 = levels[l].price;
+        order = observedOrder(p0, p1, p2);
+        double next = p2 + (p2 - p1) / (std::pow(2.0, order) - 1.0);
+        error = std::fabs(next - extrapolated);
+        extrapolated = next;
+    }
+
+    ToleranceResult result{levels[l], error, order, gridN(l), gridM(l), l + 1, error <= tolerance};
+    result.results.price = extrapolated;
+    return result;
+}
+
+} // namespace edp
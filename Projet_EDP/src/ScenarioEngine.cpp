@@ -0,0 +1,153 @@
+#include "edp/ScenarioEngine.h"
+#include "edp/Payoff.h"
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace edp {
+
+namespace {
+
+    // Paramètres partagés par un groupe : un seul opérateur par volatilité choquée
+    auto groupKey(const Contract& c, const GridChoice& g) {
+        return std::make_tuple(g.S_max, g.S_min, g.N, g.M, g.rannacher_steps, c.T, c.r, c.theta, c.sigma);
+    }
+
+    // Chocs admissibles sur la grille g du contrat (paramètres déjà vérifiés)
+    void validate(const Contract& c, const GridChoice& g, const ScenarioGrid& grid) {
+        for (double dv : grid.vol_shocks) {
+            if (!(c.sigma + dv > 0.0)) {
+                throw std::invalid_argument("Erreur Scenario: Volatilite choquee non positive.");
+            }
+        }
+        for (double s : grid.spot_shocks) {
+            double S = c.S0 * (1.0 + s);
+            if (!(S > g.S_min) || !(S < g.S_max)) {
+                throw std::invalid_argument("Erreur Scenario: Spot choque hors de la grille ]S_min, S_max[.");
+            }
+        }
+    }
+
+} // namespace
+
+ScenarioEngine::ScenarioEngine(unsigned nThreads, const ScenarioOptions& opts)
+    : pool(nThreads), options(opts) {}
+
+ScenarioResults ScenarioEngine::run(const std::vector<Contract>& portfolio, const ScenarioGrid& grid) {
+    ScenarioResults out;
+    run(portfolio, grid, out);
+    return out;
+}
+
+void ScenarioEngine::run(const std::vector<Contract>& portfolio, const ScenarioGrid& grid,
+                         ScenarioResults& out) {
+    const size_t n_contracts = portfolio.size();
+    const size_t n_spot = grid.spot_shocks.size();
+    const size_t n_scenarios = grid.size();
+
+    // Grille de chaque contrat (fixe ou automatique, à la volatilité sans choc)
+    std::vector<GridChoice> grids(n_contracts);
+    for (size_t k = 0; k < n_contracts; ++k) {
+        const Contract& c = portfolio[k];
+        if (!(c.S0 > 0.0) || !(c.K > 0.0) || !(c.T > 0.0) || !(c.sigma > 0.0)) {
+            throw std::invalid_argument("Erreur Scenario: S0, K, T et sigma doivent etre positifs.");
+        }
+        grids[k] = gridFor(c);
+        validate(c, grids[k], grid);
+    }
+
+    out.contracts = n_contracts;
+    out.scenarios = n_scenarios;
+    out.base.assign(n_contracts, 0.0);
+    out.pnl.assign(n_contracts * n_scenarios, 0.0);
+    solves = 0;
+    if (n_contracts == 0) return;
+
+    // Niveaux de volatilité : les chocs, plus le niveau sans choc (prix de base) s'il manque
+    std::vector<double> levels = grid.vol_shocks;
+    auto zero = std::find(levels.begin(), levels.end(), 0.0);
+    const size_t base_level = static_cast<size_t>(zero - levels.begin());
+    if (zero == levels.end()) levels.push_back(0.0);
+
+    // Groupes : contrats consécutifs de même clé après tri
+    std::vector<size_t> order(n_contracts);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return groupKey(portfolio[a], grids[a]) < groupKey(portfolio[b], grids[b]);
+    });
+    std::vector<size_t> group_begin;
+    for (size_t j = 0; j < n_contracts; ++j) {
+        const size_t k = order[j];
+        if (j == 0 || groupKey(portfolio[k], grids[k]) != groupKey(portfolio[order[j - 1]], grids[order[j - 1]])) {
+            group_begin.push_back(j);
+        }
+    }
+    group_begin.push_back(n_contracts);
+    const size_t n_groups = group_begin.size() - 1;
+
+    // Payoffs construits une fois, dans l'ordre des groupes
+    std::vector<std::unique_ptr<Payoff>> owned(n_contracts);
+    std::vector<const Payoff*> payoffs(n_contracts);
+    for (size_t j = 0; j < n_contracts; ++j) {
+        const Contract& c = portfolio[order[j]];
+        if (c.is_call) {
+            owned[j] = std::make_unique<PayoffCall>(c.K);
+        } else {
+            owned[j] = std::make_unique<PayoffPut>(c.K);
+        }
+        payoffs[j] = owned[j].get();
+    }
+
+    // Une tâche par (groupe, niveau de vol) ; écritures disjointes dans out
+    const size_t n_tasks = n_groups * levels.size();
+    const size_t grain = std::max<size_t>(1, n_tasks / (4 * pool.size()));
+    pool.parallelFor(n_tasks, grain, [&](size_t begin, size_t end) {
+        std::unique_ptr<PDESolver> solver;
+        std::vector<const Payoff*> group_payoffs;
+        std::vector<SolutionSlice> slices;
+
+        for (size_t task = begin; task < end; ++task) {
+            const size_t g = task / levels.size();
+            const size_t level = task % levels.size();
+            const size_t first = group_begin[g], last = group_begin[g + 1];
+            const Contract& head = portfolio[order[first]];
+            const GridChoice& domain = grids[order[first]];
+            const double sigma = head.sigma + levels[level];
+
+            if (!solver) {
+                solver = std::make_unique<PDESolver>(head.T, head.r, sigma, domain.S_max, head.theta,
+                                                     domain.N, domain.M);
+            }
+            solver->reset(head.T, head.r, sigma, domain.S_max, head.theta, domain.N, domain.M, domain.S_min);
+            solver->setRannacherSteps(domain.rannacher_steps);
+            group_payoffs.assign(payoffs.begin() + first, payoffs.begin() + last);
+            solver->solveSlices(group_payoffs, slices);
+
+            for (size_t j = first; j < last; ++j) {
+                const size_t k = order[j];
+                const Contract& c = portfolio[k];
+                const SolutionSlice& slice = slices[j - first];
+                if (level == base_level) {
+                    out.base[k] = slice.evaluate(c.S0, options.interpolation).price;
+                }
+                if (level < grid.vol_shocks.size()) {
+                    double* row = &out.pnl[k * n_scenarios + grid.index(level, 0)];
+                    for (size_t s = 0; s < n_spot; ++s) {
+                        row[s] = slice.evaluate(c.S0 * (1.0 + grid.spot_shocks[s]), options.interpolation).price;
+                    }
+                }
+            }
+        }
+    });
+    solves = n_tasks;
+
+    // Prix choqués -> P&L
+    for (size_t k = 0; k < n_contracts; ++k) {
+        double* row = &out.pnl[k * n_scenarios];
+        for (size_t j = 0; j < n_scenarios; ++j) row[j] -= out.base[k];
+    }
+}
+
+} // namespace edp
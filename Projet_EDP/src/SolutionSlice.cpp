@@ -0,0 +1,200 @@
+#include "edp/SolutionSlice.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace edp {
+
+namespace {
+
+    // Poids de Lagrange (valeur, dérivées première et seconde) en t sur les noeuds xn[0..P-1].
+    // Grille uniforme : noeuds normalisés 0, 1, ..., P-1 et t = (x - x_j0) / dx.
+    // P est connu à la compilation : les boucles sont entièrement déroulées.
+    template <size_t P>
+    inline void lagrangeWeights(const double* xn, double t, double* w0, double* w1, double* w2) {
+        for (size_t j = 0; j < P; ++j) {
+            double denom = 1.0;
+            double f0 = 1.0, f1 = 0.0, f2 = 0.0;
+
+            for (size_t m = 0; m < P; ++m) {
+                if (m == j) continue;
+                denom *= xn[j] - xn[m];
+                f0 *= t - xn[m];
+
+                double p1 = 1.0;
+                for (size_t l = 0; l < P; ++l) {
+                    if (l == j || l == m) continue;
+                    p1 *= t - xn[l];
+
+                    double p2 = 1.0;
+                    for (size_t q = 0; q < P; ++q) {
+                        if (q == j || q == m || q == l) continue;
+                        p2 *= t - xn[q];
+                    }
+                    f2 += p2;
+                }
+                f1 += p1;
+            }
+
+            w0[j] = f0 / denom;
+            w1[j] = f1 / denom;
+            w2[j] = f2 / denom;
+        }
+    }
+
+    constexpr double kNormalizedNodes[6] = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+
+    // Copie d'une Grecque nodale après contrôle de taille
+    void assignNodal(std::vector<double>& target, const std::vector<double>& values, size_t n) {
+        if (values.size() != n) {
+            throw std::invalid_argument("Erreur SolutionSlice: Grecque nodale de taille incoherente.");
+        }
+        target.assign(values.begin(), values.end());
+    }
+
+    // Interpolation d'un vecteur nodal optionnel (0 s'il est vide)
+    inline double interpolateNodal(const std::vector<double>& values, const double* w,
+                                   size_t j0, size_t P) {
+        if (values.empty()) return 0.0;
+        double v = 0.0;
+        for (size_t j = 0; j < P; ++j) v += w[j] * values[j0 + j];
+        return v;
+    }
+
+} // namespace
+
+void SolutionSlice::assignTheta(const std::vector<double>& values) { assignNodal(Theta, values, V.size()); }
+void SolutionSlice::assignVega(const std::vector<double>& values)  { assignNodal(Vega, values, V.size()); }
+void SolutionSlice::assignRho(const std::vector<double>& values)   { assignNodal(Rho, values, V.size()); }
+
+void SolutionSlice::assign(const LogGrid& nodes, const std::vector<double>& values) {
+    if (nodes.size() != values.size() || nodes.size() < 6) {
+        throw std::invalid_argument("Erreur SolutionSlice: Grille et solution incoherentes (6 noeuds minimum).");
+    }
+    grid = nodes;
+    V.assign(values.begin(), values.end());
+    Theta.clear();
+    Vega.clear();
+    Rho.clear();
+}
+
+// Interpolation linéaire du prix, Grecques par différences centrées au noeud i
+PricingResults SolutionSlice::evaluateLinear(double S0) const {
+    size_t N = V.size();
+    double target_x = std::log(S0);
+
+    // On s'assure de ne pas sortir des bornes pour le calcul de Gamma (i >= 1)
+    // Intervalle x[i] < x <= x[i+1] (convention historique : un spot sur le noeud j
+    // prend ses Grecques au noeud j-1) ; locate() renvoie le plancher, corrigé ici,
+    // ainsi que son éventuel arrondi d'un noeud.
+    const std::vector<double>& x = grid.nodes();
+    size_t i = grid.locate(target_x, 1, N - 2);
+    while (i > 1 && !(x[i] < target_x)) --i;
+    while (i < N - 2 && x[i + 1] < target_x) ++i;
+
+    // A. Interpolation du PRIX et B. DELTA / GAMMA (Différences finies sur la grille log)
+    // Chain rule : dV/dS = (dV/dx) * (1/S)
+    double ratio, dV_dx, d2V_dx2;
+    if (grid.isUniform()) {
+        double dx = grid.uniformStep();
+        ratio = (target_x - x[i]) / dx;
+        dV_dx = (V[i+1] - V[i-1]) / (2.0 * dx); // Différence centrée meilleure
+        d2V_dx2 = (V[i+1] - 2.0 * V[i] + V[i-1]) / (dx * dx);
+    } else {
+        // Différences centrées sur pas variables (h_m à gauche, h_p à droite)
+        double h_m = x[i] - x[i-1], h_p = x[i+1] - x[i];
+        ratio = (target_x - x[i]) / h_p;
+        dV_dx = (-h_p / (h_m * (h_m + h_p))) * V[i-1]
+              + ((h_p - h_m) / (h_m * h_p)) * V[i]
+              + (h_m / (h_p * (h_m + h_p))) * V[i+1];
+        d2V_dx2 = 2.0 * (V[i-1] / (h_m * (h_m + h_p)) - V[i] / (h_m * h_p) + V[i+1] / (h_p * (h_m + h_p)));
+    }
+    double price = V[i] * (1.0 - ratio) + V[i+1] * ratio;
+
+    double S_i = std::exp(x[i]);
+    double delta = dV_dx / S_i;
+
+    // Gamma = (d2V/dS2) = (d2V/dx2 - dV/dx) / S^2
+    double gamma = (d2V_dx2 - dV_dx) / (S_i * S_i);
+
+    // C. Grecques nodales, interpolées comme le prix
+    double w[2] = {1.0 - ratio, ratio};
+    double theta = interpolateNodal(Theta, w, i, 2);
+    double vega  = interpolateNodal(Vega, w, i, 2);
+    double rho   = interpolateNodal(Rho, w, i, 2);
+
+    return {price, delta, gamma, theta, vega, rho};
+}
+
+// Polynôme de Lagrange à P noeuds centré sur l'intervalle du spot.
+// Prix et Grecques sont évalués au spot exact (et non au noeud le plus proche).
+template <size_t P>
+PricingResults SolutionSlice::evaluateLagrange(double S0) const {
+    size_t N = V.size();
+    double target_x = std::log(S0);
+
+    size_t i = grid.locate(target_x, 0, N - 2);
+    size_t j0 = (i > P / 2 - 1) ? i - (P / 2 - 1) : 0;
+    j0 = std::min(j0, N - P);
+
+    // Uniforme : noeuds normalisés (poids indépendants de la grille) ; sinon noeuds réels
+    double w0[P], w1[P], w2[P];
+    double scale = 1.0;
+    if (grid.isUniform()) {
+        scale = grid.uniformStep();
+        lagrangeWeights<P>(kNormalizedNodes, (target_x - grid[j0]) / scale, w0, w1, w2);
+    } else {
+        lagrangeWeights<P>(&grid.nodes()[j0], target_x, w0, w1, w2);
+    }
+
+    double v = 0.0, v_u = 0.0, v_uu = 0.0;
+    for (size_t j = 0; j < P; ++j) {
+        v    += w0[j] * V[j0 + j];
+        v_u  += w1[j] * V[j0 + j];
+        v_uu += w2[j] * V[j0 + j];
+    }
+    double v_x  = v_u / scale;
+    double v_xx = v_uu / (scale * scale);
+
+    double theta = interpolateNodal(Theta, w0, j0, P);
+    double vega  = interpolateNodal(Vega, w0, j0, P);
+    double rho   = interpolateNodal(Rho, w0, j0, P);
+
+    // Passage de ln(S) à S : dV/dS = V_x / S, d2V/dS2 = (V_xx - V_x) / S^2
+    return {v, v_x / S0, (v_xx - v_x) / (S0 * S0), theta, vega, rho};
+}
+
+PricingResults SolutionSlice::evaluate(double S0, Interpolation method) const {
+    if (V.empty()) {
+        throw std::logic_error("Erreur SolutionSlice: Aucune solution chargee.");
+    }
+    switch (method) {
+        case Interpolation::Linear:  return evaluateLinear(S0);
+        case Interpolation::Cubic:   return evaluateLagrange<4>(S0);
+        case Interpolation::Quintic: return evaluateLagrange<6>(S0);
+    }
+    return evaluateLinear(S0);
+}
+
+void SolutionSlice::evaluate(const std::vector<double>& spots, std::vector<PricingResults>& out,
+                             Interpolation method) const {
+    if (V.empty()) {
+        throw std::logic_error("Erreur SolutionSlice: Aucune solution chargee.");
+    }
+    out.resize(spots.size());
+
+    // Schéma choisi une fois pour toute l'échelle : boucles sans branchement interne
+    switch (method) {
+        case Interpolation::Linear:
+            for (size_t k = 0; k < spots.size(); ++k) out[k] = evaluateLinear(spots[k]);
+            break;
+        case Interpolation::Cubic:
+            for (size_t k = 0; k < spots.size(); ++k) out[k] = evaluateLagrange<4>(spots[k]);
+            break;
+        case Interpolation::Quintic:
+            for (size_t k = 0; k < spots.size(); ++k) out[k] = evaluateLagrange<6>(spots[k]);
+            break;
+    }
+}
+
+} // namespace edp
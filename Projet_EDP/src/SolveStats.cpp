@@ -0,0 +1,58 @@
+#include "edp/SolveStats.h"
+
+namespace edp {
+
+const char* phaseName(SolvePhase p) {
+    switch (p) {
+        case SolvePhase::Grid:          return "grid";
+        case SolvePhase::Operator:      return "operator";
+        case SolvePhase::Payoff:        return "payoff";
+        case SolvePhase::Boundary:      return "boundary";
+        case SolvePhase::Rhs:           return "rhs";
+        case SolvePhase::LinearSolve:   return "linear_solve";
+        case SolvePhase::Update:        return "update";
+        case SolvePhase::Sensitivities: return "sensitivities";
+        case SolvePhase::Interpolation: return "interpolation";
+        case SolvePhase::Count:         break;
+    }
+    return "?";
+}
+
+uint64_t SolveStats::totalNs() const {
+    uint64_t total = 0;
+    for (uint64_t ns : phase_ns) total += ns;
+    return total;
+}
+
+double SolveStats::nodeStepsPerSecond() const {
+    uint64_t total = totalNs();
+    return total > 0 ? 1e9 * static_cast<double>(node_steps) / static_cast<double>(total) : 0.0;
+}
+
+SolveStats& SolveStats::operator+=(const SolveStats& other) {
+    for (size_t p = 0; p < kSolvePhaseCount; ++p) phase_ns[p] += other.phase_ns[p];
+    solves += other.solves;
+    steps += other.steps;
+    node_steps += other.node_steps;
+    factorizations += other.factorizations;
+    allocations += other.allocations;
+    return *this;
+}
+
+void SolveStats::writeCsv(std::ostream& out) const {
+    const uint64_t total = totalNs();
+    out << "metric,value,share\n";
+    for (size_t p = 0; p < kSolvePhaseCount; ++p) {
+        double share = total > 0 ? static_cast<double>(phase_ns[p]) / static_cast<double>(total) : 0.0;
+        out << "ns_" << phaseName(static_cast<SolvePhase>(p)) << "," << phase_ns[p] << "," << share << "\n";
+    }
+    out << "ns_total," << total << ",1\n"
+        << "solves," << solves << ",\n"
+        << "steps," << steps << ",\n"
+        << "node_steps," << node_steps << ",\n"
+        << "factorizations," << factorizations << ",\n"
+        << "allocations," << allocations << ",\n"
+        << "node_steps_per_s," << nodeStepsPerSecond() << ",\n";
+}
+
+} // namespace edp
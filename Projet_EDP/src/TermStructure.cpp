@@ -0,0 +1,50 @@
+#include "edp/TermStructure.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace edp {
+
+// Aucun noeud : value() et integral() prolongent l'unique valeur sur tout l'axe
+PiecewiseConstantCurve::PiecewiseConstantCurve(double value)
+    : values{value} {}
+
+PiecewiseConstantCurve::PiecewiseConstantCurve(const std::vector<double>& knots_,
+                                               const std::vector<double>& values_)
+    : knots(knots_), values(values_) {
+    if (knots.empty() || knots.size() != values.size()) {
+        throw std::invalid_argument("Erreur Courbe: Un noeud par valeur est attendu.");
+    }
+    for (size_t k = 0; k < knots.size(); ++k) {
+        double previous = (k == 0) ? 0.0 : knots[k - 1];
+        if (!(knots[k] > previous)) {
+            throw std::invalid_argument("Erreur Courbe: Noeuds non strictement croissants et positifs.");
+        }
+    }
+}
+
+double PiecewiseConstantCurve::value(double t) const {
+    // Premier noeud >= t : segment ]knots[k-1], knots[k]]
+    auto it = std::lower_bound(knots.begin(), knots.end(), t);
+    if (it == knots.end()) {
+        return values.back();
+    }
+    return values[static_cast<size_t>(it - knots.begin())];
+}
+
+double PiecewiseConstantCurve::integral(double t0, double t1) const {
+    double sum = 0.0;
+    double start = t0;
+    for (size_t k = 0; k < knots.size() && start < t1; ++k) {
+        if (knots[k] <= start) continue;
+        double end = std::min(knots[k], t1);
+        sum += values[k] * (end - start);
+        start = end;
+    }
+    // Au-delà du dernier noeud : dernière valeur prolongée
+    if (start < t1) {
+        sum += values.back() * (t1 - start);
+    }
+    return sum;
+}
+
+} // namespace edp
@@ -0,0 +1,93 @@
+#include "edp/ThreadPool.h"
+#include <algorithm>
+
+namespace edp {
+
+ThreadPool::ThreadPool(unsigned nThreads) {
+    if (nThreads == 0) {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(nThreads - 1);
+    for (unsigned t = 1; t < nThreads; ++t) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+// Distribution dynamique des tranches entre tous les participants
+void ThreadPool::runChunks() {
+    const auto& fn = *job;
+    for (;;) {
+        size_t begin = next.fetch_add(job_grain);
+        if (begin >= job_count) break;
+        try {
+            fn(begin, std::min(begin + job_grain, job_count));
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::workerLoop() {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        runChunks();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain,
+                             const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+
+    // Une seule tranche ou pas de worker : exécution directe
+    if (workers.empty() || count <= grain) {
+        fn(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        job_count = count;
+        job_grain = grain;
+        next.store(0);
+        pending = workers.size();
+        error = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+
+    runChunks();
+
+    std::exception_ptr failure;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return pending == 0; });
+        job = nullptr;
+        failure = error;
+    }
+    if (failure) std::rethrow_exception(failure);
+}
+
+} // namespace edp
@@ -87,9 +87,253 @@ void runBenchmark() {
     }
 }
 
+// M résolutions avec la même matrice (cas de la boucle temporelle) :
+// chemin historique (thomasAlgorithm à chaque pas) vs factorisation unique + apply().
+// Temps : EDP_Bench, suites thomas/ et factorized/
+bool runFactorizationCheck() {
+    std::cout << "\nn,steps,max_diff\n";
+
+    const std::size_t steps = 2000;
+    std::vector<std::size_t> sizes = {100, 1000, 10000};
+    bool ok = true;
+
+    for (std::size_t n : sizes) {
+        // Matrice type Crank-Nicolson : diagonale dominante
+        std::vector<double> a(n, -0.25), b(n, 1.5), c(n, -0.25);
+        a[0] = 0.0;
+        c[n - 1] = 0.0;
+
+        std::vector<double> d(n);
+        for (std::size_t i = 0; i < n; ++i)
+            d[i] = std::sin(0.01 * static_cast<double>(i));
+
+        std::vector<double> x_ref(n), x_fact(n);
+
+        // Chemin historique : élimination complète à chaque pas
+        for (std::size_t t = 0; t < steps; ++t) {
+            edp::thomasAlgorithm(a, b, c, d, x_ref);
+            d[t % n] += 1e-12 * x_ref[0]; // dépendance entre itérations
+        }
+
+        // Factorisation unique, puis descente/remontée seules
+        for (std::size_t i = 0; i < n; ++i)
+            d[i] = std::sin(0.01 * static_cast<double>(i));
+
+        edp::TridiagonalFactorization factor(a, b, c);
+        for (std::size_t t = 0; t < steps; ++t) {
+            factor.apply(d, x_fact);
+            d[t % n] += 1e-12 * x_fact[0];
+        }
+
+        double max_diff = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
+            max_diff = std::max(max_diff, std::abs(x_ref[i] - x_fact[i]));
+        if (max_diff > 1e-12) ok = false;
+
+        // Refactorisation partielle (lignes de la seconde moitié modifiées) :
+        // identique à une factorisation complète
+        std::vector<double> b2 = b;
+        for (std::size_t i = n / 2; i < n; ++i) b2[i] = 1.75;
+        edp::TridiagonalFactorization full(a, b2, c);
+        factor.refactorize(a, b2, c, n / 2);
+        std::vector<double> x_full(n), x_part(n);
+        full.apply(d, x_full);
+        factor.apply(d, x_part);
+        if (x_full != x_part) ok = false;
+
+        // Instanciation float : même système, écart de l'ordre de l'epsilon float
+        std::vector<float> af(a.begin(), a.end()), bf(b.begin(), b.end()),
+                           cf(c.begin(), c.end()), df(d.begin(), d.end()), xf;
+        edp::thomasAlgorithm(af, bf, cf, df, xf);
+        edp::thomasAlgorithm(a, b, c, d, x_ref);
+        for (std::size_t i = 0; i < n; ++i)
+            if (std::abs(static_cast<double>(xf[i]) - x_ref[i]) > 1e-5) ok = false;
+
+        std::cout << n << "," << steps << "," << max_diff << "\n";
+    }
+    return ok;
+}
+
+// Lot de systèmes entrelacés : chaque niveau SIMD disponible doit reproduire
+// thomasAlgorithm système par système (identité bit à bit attendue).
+// Temps : EDP_Bench, suite thomas_batch/
+bool runBatchedCheck() {
+    std::cout << "\nsimd_level,n,nsys,max_ulp\n";
+
+    const edp::SimdLevel best = edp::detectSimdLevel();
+    std::vector<edp::SimdLevel> levels = {edp::SimdLevel::Scalar};
+    if (best != edp::SimdLevel::Scalar) levels.push_back(edp::SimdLevel::AVX2);
+    if (best == edp::SimdLevel::AVX512) levels.push_back(edp::SimdLevel::AVX512);
+
+    const std::size_t n = 500;
+    std::vector<std::size_t> batch_sizes = {1, 7, 16, 64, 203};
+    bool ok = true;
+
+    for (std::size_t nsys : batch_sizes) {
+        // Systèmes différents par voie (sigma, r, dt différents dans le cas PDE)
+        std::size_t total = n * nsys;
+        std::vector<double> a(total), b(total), c(total), d(total);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < nsys; ++j) {
+                double s = 0.1 + 0.01 * static_cast<double>(j);
+                std::size_t idx = i * nsys + j;
+                a[idx] = (i > 0) ? -s - 0.001 * static_cast<double>(i % 7) : 0.0;
+                c[idx] = (i + 1 < n) ? -s + 0.002 * static_cast<double>(i % 5) : 0.0;
+                b[idx] = 1.0 + std::abs(a[idx]) + std::abs(c[idx]);
+                d[idx] = std::cos(0.03 * static_cast<double>(i) + static_cast<double>(j));
+            }
+        }
+
+        // Référence : thomasAlgorithm scalaire, système par système
+        std::vector<double> x_ref(total);
+        std::vector<double> as(n), bs(n), cs(n), ds(n), xs(n);
+        edp::ThomasWorkspace ws_ref;
+        for (std::size_t j = 0; j < nsys; ++j) {
+            for (std::size_t i = 0; i < n; ++i) {
+                as[i] = a[i * nsys + j];
+                bs[i] = b[i * nsys + j];
+                cs[i] = c[i * nsys + j];
+                ds[i] = d[i * nsys + j];
+            }
+            edp::thomasAlgorithm(as, bs, cs, ds, xs, ws_ref);
+            for (std::size_t i = 0; i < n; ++i) x_ref[i * nsys + j] = xs[i];
+        }
+
+        for (edp::SimdLevel level : levels) {
+            std::vector<double> x;
+            edp::ThomasWorkspace ws;
+            edp::thomasAlgorithmBatch(a, b, c, d, x, nsys, ws, level);
+
+            // Écart en ulp entre les deux résultats
+            double max_ulp = 0.0;
+            for (std::size_t idx = 0; idx < total; ++idx) {
+                double ulp = std::abs(std::nextafter(x_ref[idx], INFINITY) - x_ref[idx]);
+                max_ulp = std::max(max_ulp, std::abs(x[idx] - x_ref[idx]) / ulp);
+            }
+            if (max_ulp > 1.0) ok = false;
+
+            const char* name = (level == edp::SimdLevel::AVX512) ? "avx512"
+                             : (level == edp::SimdLevel::AVX2)   ? "avx2" : "scalar";
+            std::cout << name << "," << n << "," << nsys << "," << max_ulp << "\n";
+        }
+    }
+    return ok;
+}
+
+// Solveur partitionné : précision vs Thomas séquentiel, pour des nombres de threads
+// quelconques. Temps : EDP_Bench, suites partitioned/ et factorized/
+bool runParallelCheck() {
+    bool ok = true;
+
+    auto build = [](std::size_t n, std::vector<double>& a, std::vector<double>& b,
+                    std::vector<double>& c, std::vector<double>& d) {
+        a.assign(n, 0.0); b.assign(n, 0.0); c.assign(n, 0.0); d.assign(n, 0.0);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i > 0)     a[i] = -0.4 - 0.1 * std::sin(0.001 * static_cast<double>(i));
+            if (i + 1 < n) c[i] = -0.4 + 0.1 * std::cos(0.001 * static_cast<double>(i));
+            b[i] = 1.0 + std::abs(a[i]) + std::abs(c[i]);
+            d[i] = std::sin(0.0007 * static_cast<double>(i)) + 0.5;
+        }
+    };
+
+    std::cout << "\nn,threads,blocks,max_rel_error\n";
+    for (std::size_t n : {std::size_t(100), std::size_t(1000), std::size_t(100000)}) {
+        std::vector<double> a, b, c, d, x_ref, x;
+        build(n, a, b, c, d);
+        edp::thomasAlgorithm(a, b, c, d, x_ref);
+
+        for (unsigned threads : {1u, 2u, 3u, 4u, 8u}) {
+            edp::PartitionedTridiagonalSolver solver;
+            solver.factorize(a, b, c, threads);
+            solver.apply(d, x);
+
+            double max_rel = 0.0;
+            for (std::size_t i = 0; i < n; ++i)
+                max_rel = std::max(max_rel, std::abs(x[i] - x_ref[i]) / std::abs(x_ref[i]));
+            if (max_rel > 1e-12) ok = false;
+
+            std::cout << n << "," << threads << "," << solver.blocks() << "," << max_rel << "\n";
+        }
+    }
+    return ok;
+}
+
+// Problème à obstacle (un pas implicite de put américain) : Brennan-Schwartz contre PSOR.
+// Temps : EDP_Bench, suite projected/
+bool runProjectedCheck() {
+    std::cout << "\nn,psor_iterations,max_diff,mirror_diff\n";
+
+    const double K = 100.0, S_high = 200.0, r = 0.05, sigma = 0.2, dt = 0.01;
+    bool ok = true;
+
+    for (std::size_t n : {100, 500, 2000}) {
+        // A = I - dt L, L = 0.5 sigma^2 S^2 d2/dS2 + r S d/dS - r (M-matrice)
+        double h = S_high / static_cast<double>(n + 1);
+        std::vector<double> a(n), b(n), c(n), g(n), d(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            double S = h * static_cast<double>(i + 1);
+            double diffusion = 0.5 * sigma * sigma * S * S / (h * h);
+            double convection = r * S / (2.0 * h);
+            a[i] = -dt * (diffusion - convection);
+            b[i] = 1.0 + dt * (2.0 * diffusion + r);
+            c[i] = -dt * (diffusion + convection);
+            g[i] = std::max(K - S, 0.0);
+            d[i] = g[i];
+        }
+        a[0] = 0.0;
+        c[n - 1] = 0.0;
+
+        edp::ThomasWorkspace ws;
+        std::vector<double> x_bs, x_psor;
+
+        edp::brennanSchwartz(a, b, c, d, g, x_bs, ws, edp::ExerciseSide::Low);
+        double omega = 2.0 / (1.0 + std::sin(3.14159265358979 / static_cast<double>(n)));
+        std::size_t iterations = edp::projectedSOR(a, b, c, d, g, x_psor, omega, 1e-12);
+
+        // Système retourné : la région d'exercice passe en haut (chemin ExerciseSide::High)
+        std::vector<double> ra(n), rb(b.rbegin(), b.rend()), rc(n), rd(d.rbegin(), d.rend()), rg(g.rbegin(), g.rend());
+        for (std::size_t i = 0; i < n; ++i) {
+            ra[i] = c[n - 1 - i];
+            rc[i] = a[n - 1 - i];
+        }
+        std::vector<double> x_mirror;
+        edp::brennanSchwartz(ra, rb, rc, rd, rg, x_mirror, ws, edp::ExerciseSide::High);
+
+        double max_diff = 0.0, mirror_diff = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            max_diff = std::max(max_diff, std::abs(x_bs[i] - x_psor[i]));
+            mirror_diff = std::max(mirror_diff, std::abs(x_bs[i] - x_mirror[n - 1 - i]));
+        }
+        if (max_diff > 1e-6 || mirror_diff > 1e-12) ok = false;
+
+        std::cout << n << "," << iterations << "," << max_diff << "," << mirror_diff << "\n";
+    }
+    return ok;
+}
+
 int main() {
     try {
         runBenchmark();
+
+        if (!runFactorizationCheck()) {
+            std::cerr << "Echec : la factorisation diverge de thomasAlgorithm." << std::endl;
+            return 1;
+        }
+
+        if (!runBatchedCheck()) {
+            std::cerr << "Echec : thomasAlgorithmBatch differe de thomasAlgorithm de plus d'1 ulp." << std::endl;
+            return 1;
+        }
+
+        if (!runParallelCheck()) {
+            std::cerr << "Echec : le solveur partitionne differe de thomasAlgorithm." << std::endl;
+            return 1;
+        }
+
+        if (!runProjectedCheck()) {
+            std::cerr << "Echec : Brennan-Schwartz differe de PSOR." << std::endl;
+            return 1;
+        }
     } catch (const std::exception& e) {
         std::cerr << "Exception non gérée : " << e.what() << std::endl;
         return 1;
@@ -1,11 +1,41 @@
 #include "edp/PDESolver.h"
 #include "edp/Payoff.h"
+#include "edp/Richardson.h"
+#include "edp/HestonSolver.h"
+#include "edp/BatchPricer.h"
+#include "edp/PricingEngine.h"
+#include "edp/ScenarioEngine.h"
+#include "edp/ImpliedVol.h"
+#include "edp/BlackScholes.h"
 
 #include <iostream>
 #include <iomanip>
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <complex>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+// === ALLOCATEUR DE COMPTAGE ===
+// Remplace l'opérateur new global pour compter les allocations dynamiques
+static std::size_t g_allocations = 0;
+
+// noinline : évite que GCC, après inlining, signale à tort un couple malloc/delete
+__attribute__((noinline)) void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
 
 // === OUTILS ANALYTIQUES (Black-Scholes) ===
 
@@ -27,6 +57,27 @@ static double bs_call_price(double S0, double K, double T, double r, double sigm
     return S0 * norm_cdf(d1) - K * std::exp(-r * T) * norm_cdf(d2);
 }
 
+// Densité normale standard
+static double norm_pdf(double x) {
+    return 0.3989422804014327 * std::exp(-0.5 * x * x); // 1/sqrt(2 pi)
+}
+
+// Grecques analytiques du Call européen (Theta en temps calendaire)
+static edp::PricingResults bs_call_greeks(double S0, double K, double T, double r, double sigma) {
+    double vol_sqrtT = sigma * std::sqrt(T);
+    double d1 = (std::log(S0 / K) + (r + 0.5 * sigma * sigma) * T) / vol_sqrtT;
+    double d2 = d1 - vol_sqrtT;
+    double discount = std::exp(-r * T);
+
+    double price = S0 * norm_cdf(d1) - K * discount * norm_cdf(d2);
+    double delta = norm_cdf(d1);
+    double gamma = norm_pdf(d1) / (S0 * vol_sqrtT);
+    double theta = -S0 * norm_pdf(d1) * sigma / (2.0 * std::sqrt(T)) - r * K * discount * norm_cdf(d2);
+    double vega  = S0 * norm_pdf(d1) * std::sqrt(T);
+    double rho   = K * T * discount * norm_cdf(d2);
+    return {price, delta, gamma, theta, vega, rho};
+}
+
 // === STRUCTURE DE DONNÉES ===
 
 struct TestCase {
@@ -37,6 +88,1323 @@ struct TestCase {
     double sigma;
 };
 
+// === TEST : ÉTAT STABLE SANS ALLOCATION ===
+// Après un premier appel (dimensionnement), solve() ne doit plus allouer
+static bool checkSteadyStateAllocations() {
+    edp::PDESolver solver(1.0, 0.05, 0.20, 500.0, 0.5, 200, 500);
+    edp::PayoffCall payoff(100.0);
+
+    edp::PricingResults warmup = solver.solve(payoff, 100.0);
+
+    std::size_t before = g_allocations;
+    edp::PricingResults res = solver.solve(payoff, 100.0);
+    std::size_t allocations = g_allocations - before;
+
+    std::cout << "steady_state_allocations," << allocations << "\n";
+    return allocations == 0 && res.price == warmup.price;
+}
+
+// === TEST : SOLVE PAR LOT ===
+// Le lot (strikes et Call/Put mélangés) doit reproduire les solves individuels
+static bool checkBatchedSolve() {
+    const double T = 1.0, r = 0.05, sigma = 0.20, S_max = 500.0;
+    const std::size_t N = 200, M = 500;
+
+    std::vector<edp::PayoffCall> calls = {edp::PayoffCall(80.0), edp::PayoffCall(100.0), edp::PayoffCall(120.0)};
+    std::vector<edp::PayoffPut>  puts  = {edp::PayoffPut(90.0),  edp::PayoffPut(110.0)};
+
+    std::vector<const edp::Payoff*> payoffs;
+    for (const auto& c : calls) payoffs.push_back(&c);
+    for (const auto& p : puts)  payoffs.push_back(&p);
+    std::vector<double> spots = {100.0, 95.0, 105.0, 100.0, 90.0};
+
+    edp::PDESolver batch_solver(T, r, sigma, S_max, 0.5, N, M);
+    std::vector<edp::PricingResults> batch = batch_solver.solve(payoffs, spots);
+
+    double max_diff = 0.0;
+    for (std::size_t k = 0; k < payoffs.size(); ++k) {
+        edp::PDESolver solver(T, r, sigma, S_max, 0.5, N, M);
+        edp::PricingResults single = solver.solve(*payoffs[k], spots[k]);
+        max_diff = std::max(max_diff, std::fabs(single.price - batch[k].price));
+        max_diff = std::max(max_diff, std::fabs(single.delta - batch[k].delta));
+        max_diff = std::max(max_diff, std::fabs(single.gamma - batch[k].gamma));
+    }
+
+    std::cout << "batched_vs_single_max_diff," << max_diff << "\n";
+    return batch.size() == payoffs.size() && max_diff < 1e-12;
+}
+
+// === TEST : GRILLE NON UNIFORME ===
+// Grille étirée (sinh) autour du strike contre grille uniforme : erreur en fonction de N
+static bool checkNonUniformGrid() {
+    const double T = 1.0, r = 0.05, sigma = 0.20, S_max = 500.0;
+    const double K = 100.0, S0 = 100.0;
+    const std::size_t M = 1000;
+    const double bs = bs_call_price(S0, K, T, r, sigma);
+    edp::PayoffCall call(K);
+
+    std::cout << "N,err_uniform,err_sinh\n";
+    double err_uniform_ref = 0.0, err_sinh_coarse = 0.0;
+    for (std::size_t N : {50, 100, 150, 200, 300, 400, 600, 800}) {
+        edp::PDESolver uniform(T, r, sigma, S_max, 0.5, N, M);
+        edp::PDESolver stretched(T, r, sigma, S_max, 0.5, N, M);
+        stretched.setSinhGrid(K, 0.1);
+
+        double err_u = std::fabs(uniform.solveSlice(call).evaluate(S0).price - bs);
+        double err_s = std::fabs(stretched.solveSlice(call).evaluate(S0).price - bs);
+        std::cout << N << "," << err_u << "," << err_s << "\n";
+
+        if (N == 300) err_uniform_ref = err_u;
+        if (N == 100) err_sinh_coarse = err_s;
+    }
+
+    // Grille utilisateur : mêmes noeuds que la grille uniforme -> même prix
+    edp::PDESolver reference(T, r, sigma, S_max, 0.5, 200, M);
+    edp::PDESolver user(T, r, sigma, S_max, 0.5, 200, M);
+    std::vector<double> S_nodes(200);
+    const edp::SolutionSlice reference_slice = reference.solveSlice(call);
+    const std::vector<double>& x = reference_slice.nodes();
+    for (std::size_t i = 0; i < x.size(); ++i) S_nodes[i] = std::exp(x[i]);
+    user.setGridNodes(S_nodes);
+    double custom_diff = std::fabs(user.solve(call, S0).price - reference.solve(call, S0).price);
+    std::cout << "custom_vs_uniform_diff," << custom_diff << "\n";
+
+    // Objectif : la grille étirée fait au moins aussi bien que la grille uniforme avec 3x moins de noeuds
+    return err_sinh_coarse <= err_uniform_ref && custom_diff < 1e-10;
+}
+
+// === TEST : MODE PRÉCISION CIBLE (RICHARDSON) ===
+// Prix extrapolé contre Black-Scholes (temps contre une grille fine : EDP_Bench, tolerance/)
+static bool checkToleranceMode() {
+    const double T = 1.0, r = 0.05, sigma = 0.20, S_max = 400.0, K = 100.0;
+    edp::PayoffCall call(K);
+    edp::ToleranceOptions options;
+    options.S_center = K;
+
+    std::cout << "S0,tolerance,price,error_estimate,error_bs,N,M,levels\n";
+    bool ok = true;
+    for (double S0 : {90.0, 100.0, 110.0}) {
+        const double bs = bs_call_price(S0, K, T, r, sigma);
+        for (double tolerance : {1e-3, 1e-4}) {
+            edp::ToleranceResult res = edp::solveToTolerance(call, S0, T, r, sigma, S_max, 0.5, tolerance, options);
+
+            double err = std::fabs(res.results.price - bs);
+            std::cout << S0 << "," << tolerance << "," << res.results.price << "," << res.error_estimate << ","
+                      << err << "," << res.N << "," << res.M << "," << res.levels << "\n";
+
+            ok = ok && res.converged && err <= tolerance;
+        }
+    }
+
+    // Entrée invalide en mode parallèle : exception dans l'appelant, pas std::terminate
+    edp::ToleranceOptions invalid = options;
+    invalid.parallel = true;
+    invalid.alpha = 0.0;
+    bool invalid_throws = false;
+    try {
+        (void)edp::solveToTolerance(call, 100.0, T, r, sigma, S_max, 0.5, 1e-3, invalid);
+    } catch (const std::invalid_argument&) {
+        invalid_throws = true;
+    }
+    std::cout << "tolerance_parallel_invalid_throws," << invalid_throws << "\n";
+    return ok && invalid_throws;
+}
+
+// === TEST : DÉMARRAGE DE RANNACHER ET PAS ADAPTATIFS ===
+// Gamma près du strike avec peu de pas de temps
+static bool checkTimeStepping() {
+    const double T = 0.25, r = 0.05, sigma = 0.20, S_max = 500.0, K = 100.0;
+    const std::size_t N = 800;
+    edp::PayoffCall call(K);
+
+    std::vector<double> spots;
+    for (double s = 90.0; s <= 110.0; s += 0.5) spots.push_back(s);
+
+    // Erreur max sur le Gamma (et le prix) le long de l'échelle de spots
+    auto gammaError = [&](edp::PDESolver& solver, double& price_err) {
+        edp::SolutionSlice slice = solver.solveSlice(call);
+        std::vector<edp::PricingResults> res;
+        slice.evaluate(spots, res);
+        double gamma_err = 0.0;
+        price_err = 0.0;
+        for (std::size_t k = 0; k < spots.size(); ++k) {
+            edp::PricingResults bs = bs_call_greeks(spots[k], K, T, r, sigma);
+            gamma_err = std::max(gamma_err, std::fabs(res[k].gamma - bs.gamma));
+            price_err = std::max(price_err, std::fabs(res[k].price - bs.price));
+        }
+        return gamma_err;
+    };
+
+    std::cout << "scheme,M,steps,factorizations,max_gamma_err,max_price_err\n";
+    double cn_fine = 0.0, rannacher_coarse = 0.0, cn_coarse = 0.0, adaptive_err = 0.0;
+    // Gamma : CN à 10 pas, Rannacher à 10 pas, CN à 200 pas, adaptatif
+    std::size_t adaptive_steps = 0;
+    for (std::size_t M : {10, 25, 200}) {
+        for (int mode = 0; mode < 4; ++mode) {
+            edp::PDESolver solver(T, r, sigma, S_max, 0.5, N, M);
+            const char* name = "crank_nicolson";
+            if (mode >= 1) { solver.setRannacherSteps(2); name = "rannacher"; }
+            if (mode == 2) { solver.setGeometricTimeGrid(1.1); name = "rannacher_geometric"; }
+            if (mode == 3) { solver.setAdaptiveTimeGrid(0.1); name = "rannacher_adaptive"; }
+
+            double price_err = 0.0;
+            double gamma_err = gammaError(solver, price_err);
+            std::cout << name << "," << M << "," << solver.getStepCount() << ","
+                      << solver.getFactorizationCount() << "," << gamma_err << "," << price_err << "\n";
+
+            if (mode == 0 && M == 10) cn_coarse = gamma_err;
+            if (mode == 0 && M == 200) cn_fine = gamma_err;
+            if (mode == 1 && M == 10) rannacher_coarse = gamma_err;
+            if (mode == 3 && M == 25) { adaptive_err = gamma_err; adaptive_steps = solver.getStepCount(); }
+        }
+    }
+
+    // Le solve par lot suit la même grille temporelle (un seul contrat : pas identiques)
+    edp::PDESolver single(T, r, sigma, S_max, 0.5, N, 25);
+    edp::PDESolver batch(T, r, sigma, S_max, 0.5, N, 25);
+    single.setRannacherSteps(2);
+    single.setAdaptiveTimeGrid(0.1);
+    batch.setRannacherSteps(2);
+    batch.setAdaptiveTimeGrid(0.1);
+    double single_price = single.solve(call, K).price;
+    double batch_price = batch.solve(std::vector<const edp::Payoff*>{&call}, std::vector<double>{K})[0].price;
+    std::cout << "time_stepping_batch_vs_single_diff," << std::fabs(single_price - batch_price) << "\n";
+
+    // Rannacher supprime les oscillations de CN : à 10 pas, Gamma aussi propre que CN à 200 pas
+    return rannacher_coarse * 10.0 < cn_coarse
+        && rannacher_coarse <= 2.0 * cn_fine
+        && adaptive_err <= 2.0 * cn_fine && adaptive_steps < 200
+        && std::fabs(single_price - batch_price) < 1e-12;
+}
+
+// === TEST : PUT AMÉRICAIN ===
+// Brennan-Schwartz (O(N) par pas) contre PSOR, frontière d'exercice (temps : EDP_Bench, american/)
+static bool checkAmericanPut() {
+    const double T = 1.0, r = 0.05, sigma = 0.20, S_max = 400.0, K = 100.0;
+    const std::size_t N = 800, M = 400;
+    edp::PayoffPut put(K);
+
+    edp::PDESolver european(T, r, sigma, S_max, 0.5, N, M);
+    edp::PDESolver brennan(T, r, sigma, S_max, 0.5, N, M);
+    edp::PDESolver psor(T, r, sigma, S_max, 0.5, N, M);
+    for (edp::PDESolver* solver : {&european, &brennan, &psor}) solver->setRannacherSteps(2);
+    brennan.setExerciseStyle(edp::ExerciseStyle::American, edp::AmericanMethod::BrennanSchwartz);
+    psor.setExerciseStyle(edp::ExerciseStyle::American, edp::AmericanMethod::PSOR);
+
+    edp::SolutionSlice slice_bs = brennan.solveSlice(put);
+    edp::SolutionSlice slice_psor = psor.solveSlice(put);
+    edp::SolutionSlice slice_eu = european.solveSlice(put);
+
+    std::cout << "S0,european,american_bs,american_psor,diff\n";
+    bool ok = true;
+    double max_diff = 0.0;
+    for (double S0 : {80.0, 90.0, 100.0, 110.0, 120.0}) {
+        double eu = slice_eu.evaluate(S0).price;
+        double am = slice_bs.evaluate(S0).price;
+        double am_psor = slice_psor.evaluate(S0).price;
+        max_diff = std::max(max_diff, std::fabs(am - am_psor));
+        std::cout << S0 << "," << eu << "," << am << "," << am_psor << "," << std::fabs(am - am_psor) << "\n";
+        // Valeur d'exercice respectée (à l'erreur d'interpolation cubique près)
+        ok = ok && am >= eu && am >= K - S0 - 1e-4;
+    }
+
+    // Référence de la littérature (arbre binomial fin) : P(100) = 6.0904
+    double atm_error = std::fabs(slice_bs.evaluate(100.0).price - 6.0904);
+
+    // Frontière : un point par pas, sous le strike, décroissante avec la maturité restante
+    const std::vector<edp::ExerciseBoundaryPoint>& boundary = brennan.getExerciseBoundary();
+    bool boundary_ok = boundary.size() == M + 2; // 2 pas de Rannacher en deux demi-pas
+    for (std::size_t k = 1; k < boundary.size(); ++k) {
+        boundary_ok = boundary_ok && boundary[k].S <= boundary[k-1].S + 1e-12 && boundary[k].S < K;
+    }
+
+    std::cout << "american_atm_error," << atm_error << "\n";
+    std::cout << "exercise_boundary_T," << boundary.back().S << "\n";
+
+    return ok && max_diff < 1e-6 && atm_error < 5e-3 && boundary_ok;
+}
+
+// === TEST : CACHE DES GRILLES ET OPÉRATEURS ===
+// Compteurs, résultats identiques, LRU, threads (coût de préparation : EDP_Bench, setup/)
+static bool checkOperatorCache() {
+    const double T = 1.0, r = 0.05, sigma = 0.20, S_max = 500.0;
+    const std::size_t N = 400, M = 200;
+    edp::OperatorCache& cache = edp::OperatorCache::instance();
+    edp::PayoffCall call(100.0);
+    edp::PayoffPut put(95.0);
+    bool ok = true;
+
+    // 1. Deuxième solveur aux mêmes paramètres : aucune préparation
+    cache.clear();
+    edp::PDESolver first(T, r, sigma, S_max, 0.5, N, M);
+    double p1 = first.solve(call, 100.0).price;
+    edp::PDESolver second(T, r, sigma, S_max, 0.5, N, M);
+    double p2 = second.solve(put, 100.0).price;
+    double p2_again = second.solve(call, 100.0).price;
+    ok = ok && cache.grids.misses() == 1 && cache.grids.hits() == 1
+            && cache.operators.misses() == 1 && cache.operators.hits() == 2
+            && second.getFactorizationCount() == 0 && p1 == p2_again;
+
+    edp::PDESolver uncached(T, r, sigma, S_max, 0.5, N, M);
+    uncached.setUseCache(false);
+    ok = ok && uncached.solve(put, 100.0).price == p2;
+
+    std::cout << "grid_hits,grid_misses,operator_hits,operator_misses\n";
+    std::cout << cache.grids.hits() << "," << cache.grids.misses() << ","
+              << cache.operators.hits() << "," << cache.operators.misses() << "\n";
+
+    // 2. Éviction LRU : capacité 2, trois volatilités
+    cache.clear();
+    cache.setCapacity(32, 2);
+    for (double vol : {0.1, 0.2, 0.3}) {
+        edp::PDESolver solver(T, r, vol, S_max, 0.5, N, M);
+        solver.precomputeMatrices();
+    }
+    ok = ok && cache.operators.size() == 2;
+    cache.setCapacity(32, 64);
+
+    // 3. Budget en octets : place pour deux opérateurs et demi, trois volatilités
+    cache.clear();
+    edp::PDESolver sized(T, r, 0.1, S_max, 0.5, N, M);
+    sized.precomputeMatrices();
+    const std::size_t operator_bytes = cache.operators.bytes();
+    cache.setCapacityBytes(16u << 20, 5 * operator_bytes / 2);
+    for (double vol : {0.2, 0.3}) {
+        edp::PDESolver solver(T, r, vol, S_max, 0.5, N, M);
+        solver.precomputeMatrices();
+    }
+    const std::size_t kept = cache.operators.size();
+    ok = ok && operator_bytes > 0 && kept == 2 && cache.operators.bytes() == 2 * operator_bytes;
+    std::cout << "operator_bytes,operators_kept\n" << operator_bytes << "," << kept << "\n";
+    cache.setCapacityBytes(16u << 20, 64u << 20);
+
+    // 4. Pas adaptatifs et opérateurs non partagés : hors du cache, mêmes prix
+    cache.clear();
+    edp::PDESolver adaptive(T, r, sigma, S_max, 0.5, N, M);
+    adaptive.setAdaptiveTimeGrid(0.1);
+    double p_adaptive = adaptive.solve(call, 100.0).price;
+    edp::PDESolver private_ops(T, r, 0.25, S_max, 0.5, N, M);
+    private_ops.setShareOperators(false);
+    double p_private = private_ops.solve(call, 100.0).price;
+    edp::PDESolver shared_ops(T, r, 0.25, S_max, 0.5, N, M);
+    ok = ok && cache.operators.size() == 0 && cache.grids.size() == 1
+            && shared_ops.solve(call, 100.0).price == p_private && std::isfinite(p_adaptive);
+
+    // 5. Accès concurrents : mêmes prix que le solve séquentiel
+    std::vector<double> prices(4, 0.0);
+    std::vector<std::thread> workers;
+    for (std::size_t k = 0; k < prices.size(); ++k) {
+        workers.emplace_back([&, k] {
+            edp::PDESolver solver(T, r, sigma, S_max, 0.5, N, M);
+            prices[k] = solver.solve(call, 100.0).price;
+        });
+    }
+    for (auto& w : workers) w.join();
+    for (double p : prices) ok = ok && p == p1;
+
+    return ok;
+}
+
+// === TEST : STRUCTURE PAR TERME ===
+// r(t), sigma(t) constantes par morceaux :
+// Black-Scholes avec r moyen et variance intégrée, une factorisation par segment
+static bool checkTermStructure() {
+    const double T = 1.0, S_max = 500.0, K = 100.0, S0 = 100.0;
+    const std::size_t N = 800, M = 400;
+    edp::PayoffCall call(K);
+
+    // 1. Courbes plates découpées en segments : même prix que les scalaires
+    edp::PDESolver scalar(T, 0.05, 0.20, S_max, 0.5, N, M);
+    edp::PDESolver flat(T, 0.05, 0.20, S_max, 0.5, N, M);
+    flat.setRateCurve(edp::PiecewiseConstantCurve({0.25, 0.5, 0.75}, {0.05, 0.05, 0.05}));
+    flat.setVolatilityCurve(edp::PiecewiseConstantCurve({0.5}, {0.20}));
+    double flat_diff = std::fabs(scalar.solve(call, S0).price - flat.solve(call, S0).price);
+
+    // 2. Courbes réalistes : r croissant, sigma décroissant, noeuds non communs
+    edp::PiecewiseConstantCurve rates({0.25, 0.5, 1.0}, {0.02, 0.035, 0.05});
+    edp::PiecewiseConstantCurve vols({0.1, 0.4, 1.0}, {0.35, 0.25, 0.18});
+    double r_avg = rates.integral(0.0, T) / T;
+    double sigma_eff = std::sqrt((0.1 * 0.35 * 0.35 + 0.3 * 0.25 * 0.25 + 0.6 * 0.18 * 0.18) / T);
+
+    edp::PDESolver curved(T, 0.0, 0.0, S_max, 0.5, N, M);
+    curved.setUseCache(false);
+    curved.setRateCurve(rates);
+    curved.setVolatilityCurve(vols);
+
+    std::cout << "S0,price_BS_eff,price_PDE,abs_error,factorizations\n";
+    double max_err = 0.0;
+    edp::SolutionSlice slice = curved.solveSlice(call);
+    for (double spot : {80.0, 100.0, 120.0}) {
+        double bs = bs_call_price(spot, K, T, r_avg, sigma_eff);
+        double pde = slice.evaluate(spot).price;
+        max_err = std::max(max_err, std::fabs(pde - bs));
+        std::cout << spot << "," << bs << "," << pde << "," << std::fabs(pde - bs) << ","
+                  << curved.getFactorizationCount() << "\n";
+    }
+    std::cout << "term_structure_flat_diff," << flat_diff << "\n";
+
+    // 3. Nombre de pas : exactement M quelles que soient les longueurs des segments
+    //    (restes non entiers, segments de moins d'un pas), aucun noeud pour une courbe plate
+    edp::PiecewiseConstantCurve uneven({0.013, 0.021, 0.1234, 0.3579, 0.6, 0.77, 0.9013},
+                                       {0.05, 0.04, 0.03, 0.045, 0.02, 0.035, 0.05});
+    bool steps_ok = edp::PiecewiseConstantCurve(0.05).getKnots().empty();
+    std::cout << "M,steps_taken,price\n";
+    for (std::size_t steps : {std::size_t{20}, std::size_t{333}, std::size_t{400}}) {
+        edp::PDESolver split(T, 0.05, 0.20, S_max, 0.5, 200, steps);
+        split.setRateCurve(uneven);
+        split.setVolatilityCurve(edp::PiecewiseConstantCurve(0.20));
+        double price = split.solve(call, S0).price;
+        std::cout << steps << "," << split.getStepCount() << "," << price << "\n";
+        steps_ok = steps_ok && split.getStepCount() == steps && std::isfinite(price);
+    }
+
+    // Noeuds dans ]0, T[ : 0.1, 0.25, 0.4, 0.5 -> 5 segments, 5 factorisations pour 400 pas
+    return flat_diff < 1e-10 && max_err < 5e-3 && curved.getFactorizationCount() == 5 && steps_ok;
+}
+
+// === TEST : VOLATILITÉ LOCALE ===
+// 1. Surface plate / constante en S : mêmes prix que sigma scalaire / courbe sigma(t)
+// 2. Tranches identiques ou modifiées sur les ailes seulement : opérateur réutilisé
+//    ou réassemblé partiellement (moins de lignes et de factorisations)
+// Coût face à sigma constant : EDP_Bench, local_vol/
+static bool checkLocalVolatility() {
+    const double T = 1.0, r = 0.05, S_max = 500.0, K = 100.0, S0 = 100.0;
+    const std::size_t N = 400, M = 200;
+    edp::PayoffCall call(K);
+
+    edp::PDESolver scalar(T, r, 0.20, S_max, 0.5, N, M);
+    scalar.setSinhGrid(K, 0.1);
+    edp::PDESolver flat(T, r, 0.0, S_max, 0.5, N, M);
+    flat.setSinhGrid(K, 0.1);
+    flat.setLocalVolatility(edp::LocalVolSurface({1.0}, {100.0}, {0.20}));
+    double flat_diff = std::fabs(scalar.solve(call, S0).price - flat.solve(call, S0).price);
+
+    edp::PDESolver curve(T, r, 0.0, S_max, 0.5, N, M);
+    curve.setSinhGrid(K, 0.1);
+    curve.setVolatilityCurve(edp::PiecewiseConstantCurve({0.3, 0.6, 1.0}, {0.30, 0.22, 0.18}));
+    edp::PDESolver sliced(T, r, 0.0, S_max, 0.5, N, M);
+    sliced.setSinhGrid(K, 0.1);
+    sliced.setLocalVolatility(edp::LocalVolSurface({0.3, 0.6, 1.0}, {50.0, 200.0},
+                                                   {0.30, 0.30, 0.22, 0.22, 0.18, 0.18}));
+    double curve_diff = std::fabs(curve.solve(call, S0).price - sliced.solve(call, S0).price);
+
+    // Tranches : smile, smile identique, aile droite relevée, smile complet différent
+    std::vector<double> spots = {50.0, 80.0, 100.0, 120.0, 300.0, 400.0};
+    std::vector<double> vols = {
+        0.35, 0.26, 0.20, 0.19, 0.22, 0.25,
+        0.35, 0.26, 0.20, 0.19, 0.22, 0.25,
+        0.35, 0.26, 0.20, 0.19, 0.22, 0.40,
+        0.40, 0.30, 0.22, 0.20, 0.24, 0.28};
+    edp::LocalVolSurface smile({0.25, 0.5, 0.75, 1.0}, spots, vols);
+    edp::PDESolver incremental(T, r, 0.0, S_max, 0.5, N, M);
+    incremental.setSinhGrid(K, 0.1);
+    incremental.setLocalVolatility(smile);
+    edp::PricingResults lv = incremental.solve(call, S0);
+
+    std::size_t rows = N - 2;
+    std::size_t full_rows = 4 * rows;
+    std::cout << "\nlocal_vol_check,value\n";
+    std::cout << "flat_surface_diff," << flat_diff << "\n";
+    std::cout << "time_slices_diff," << curve_diff << "\n";
+    std::cout << "smile_price," << lv.price << "\n";
+    std::cout << "factorizations," << incremental.getFactorizationCount() << "\n";
+    std::cout << "assembled_rows," << incremental.getAssembledRowCount() << "\n";
+    std::cout << "full_rebuild_rows," << full_rows << "\n";
+
+    // 1 assemblage complet, tranche 2 réutilisée, tranches 3 (aile) et 4 partielles
+    return flat_diff < 1e-12 && curve_diff < 1e-12
+        && incremental.getFactorizationCount() == 3
+        && incremental.getAssembledRowCount() < 3 * rows
+        && lv.price > 0.0;
+}
+
+// === TEST : MOTEUR ADI DE HESTON ===
+
+// Call de Heston semi-analytique (fonction caractéristique, forme « little trap »
+// d'Albrecher et al.), intégrée par Simpson sur [0, 200]
+static double heston_call_price(double S0, double K, double T, double r, double v0,
+                                const edp::HestonParameters& p) {
+    using cd = std::complex<double>;
+    const cd i(0.0, 1.0);
+    auto phi = [&](cd u) {
+        cd beta = p.kappa - p.rho * p.xi * i * u;
+        cd d = std::sqrt(beta * beta + p.xi * p.xi * (i * u + u * u));
+        cd g = (beta - d) / (beta + d);
+        cd e = std::exp(-d * T);
+        cd C = r * i * u * T + p.kappa * p.theta / (p.xi * p.xi)
+             * ((beta - d) * T - 2.0 * std::log((1.0 - g * e) / (1.0 - g)));
+        cd D = (beta - d) / (p.xi * p.xi) * (1.0 - e) / (1.0 - g * e);
+        return std::exp(C + D * v0 + i * u * std::log(S0));
+    };
+
+    const std::size_t n = 4000;
+    const double u_max = 200.0, h = u_max / n;
+    const cd phi_shift = phi(-i);
+    double P1 = 0.0, P2 = 0.0;
+    for (std::size_t k = 0; k <= n; ++k) {
+        double u = std::max(k * h, 1e-10);
+        double w = (k == 0 || k == n) ? 1.0 : (k % 2 ? 4.0 : 2.0);
+        cd kernel = std::exp(-i * u * std::log(K)) / (i * u);
+        P1 += w * std::real(kernel * phi(u - i) / phi_shift);
+        P2 += w * std::real(kernel * phi(u));
+    }
+    const double pi = std::acos(-1.0);
+    P1 = 0.5 + P1 * h / 3.0 / pi;
+    P2 = 0.5 + P2 * h / 3.0 / pi;
+    return S0 * P1 - K * std::exp(-r * T) * P2;
+}
+
+// 1. xi -> 0 et v0 = theta : variance constante, prix de Black-Scholes
+// 2. Paramètres standard : prix semi-analytique, Douglas et Craig-Sneyd
+// 3. Résultat indépendant du nombre de threads (temps : EDP_Bench, heston/)
+static bool checkHestonADI() {
+    const double T = 1.0, r = 0.025, K = 100.0, S0 = 100.0;
+    const double S_max = 800.0, v_max = 1.0;
+    edp::PayoffCall call(K);
+
+    edp::HestonParameters flat{2.0, 0.04, 1e-4, 0.0};
+    edp::HestonADISolver bs_limit(T, r, flat, S_max, v_max, 200, 60, 100);
+    double bs = bs_call_price(S0, K, T, r, 0.2);
+    double bs_err = std::fabs(bs_limit.solve(call, S0, 0.04).price - bs);
+
+    edp::HestonParameters model{1.5, 0.04, 0.3, -0.9};
+    double ref = heston_call_price(S0, K, T, r, 0.04, model);
+
+    std::cout << "\nscheme,Nx,Nv,M,price_ref,price_ADI,abs_error,delta,gamma,vega\n";
+    double max_err = 0.0;
+    bool rho_nan = true; // Rho non calculé : NaN, pas 0
+    for (edp::AdiScheme kind : {edp::AdiScheme::Douglas, edp::AdiScheme::CraigSneyd}) {
+        edp::HestonADISolver solver(T, r, model, S_max, v_max, 200, 100, 100);
+        solver.setScheme(kind);
+        edp::PricingResults res = solver.solve(call, S0, 0.04);
+        double err = std::fabs(res.price - ref);
+        max_err = std::max(max_err, err);
+        rho_nan = rho_nan && std::isnan(res.rho);
+        std::cout << (kind == edp::AdiScheme::Douglas ? "Douglas" : "CraigSneyd") << ",200,100,100,"
+                  << ref << "," << res.price << "," << err << ","
+                  << res.delta << "," << res.gamma << "," << res.vega << "\n";
+    }
+    std::cout << "heston_bs_limit_error," << bs_err << "\n";
+
+    // Lignes résolues sur 1 à 4 threads : résultats identiques
+    const std::size_t Nx = 400, Nv = 200, M = 100;
+    std::cout << "\nthreads,Nx,Nv,M,price\n";
+    double price_seq = 0.0, max_thread_diff = 0.0;
+    for (unsigned n_threads : {1u, 2u, 4u}) {
+        edp::HestonADISolver solver(T, r, model, S_max, v_max, Nx, Nv, M);
+        solver.setThreads(n_threads);
+        double price = solver.solve(call, S0, 0.04).price;
+        if (n_threads == 1) price_seq = price;
+        max_thread_diff = std::max(max_thread_diff, std::fabs(price - price_seq));
+        std::cout << n_threads << "," << Nx << "," << Nv << "," << M << "," << price << "\n";
+    }
+
+    // Grille 2x plus fine : erreur divisée par ~4 (ordre 2 en espace)
+    double fine_err = std::fabs(price_seq - ref);
+    std::cout << "heston_fine_grid_error," << fine_err << "\n";
+    return bs_err < 2e-2 && max_err < 2e-2 && fine_err < 5e-3 && max_thread_diff == 0.0 && rho_nan;
+}
+
+// === TEST : PRÉCISION MIXTE DU SOLVE PAR LOT ===
+// Même lot en double, float et float + correction de défaut : écart au double
+// (débit : EDP_Bench, batch/)
+static bool checkMixedPrecision() {
+    const double T = 1.0, r = 0.05, sigma = 0.20, S_max = 500.0;
+    const std::size_t N = 1000, M = 500, K = 64;
+
+    std::vector<edp::PayoffCall> calls;
+    std::vector<const edp::Payoff*> payoffs;
+    std::vector<double> spots(K, 100.0);
+    calls.reserve(K);
+    for (std::size_t k = 0; k < K; ++k) {
+        calls.emplace_back(60.0 + 80.0 * static_cast<double>(k) / (K - 1));
+    }
+    for (const auto& c : calls) payoffs.push_back(&c);
+
+    std::cout << "\nprecision,N,M,contracts,max_price_diff,max_theta_diff\n";
+    std::vector<edp::PricingResults> reference;
+    double float_err = 0.0, mixed_err = 0.0;
+    for (edp::Precision p : {edp::Precision::Double, edp::Precision::Float, edp::Precision::Mixed}) {
+        edp::PDESolver solver(T, r, sigma, S_max, 0.5, N, M);
+        solver.setPrecision(p);
+        std::vector<edp::PricingResults> res = solver.solve(payoffs, spots);
+
+        if (p == edp::Precision::Double) reference = res;
+        double price_diff = 0.0, theta_diff = 0.0;
+        for (std::size_t k = 0; k < K; ++k) {
+            price_diff = std::max(price_diff, std::fabs(res[k].price - reference[k].price));
+            theta_diff = std::max(theta_diff, std::fabs(res[k].theta - reference[k].theta));
+        }
+        if (p == edp::Precision::Float) float_err = price_diff;
+        if (p == edp::Precision::Mixed) mixed_err = price_diff;
+
+        const char* name = (p == edp::Precision::Double) ? "double"
+                         : (p == edp::Precision::Float) ? "float" : "mixed";
+        std::cout << name << "," << N << "," << M << "," << K << "," << price_diff << "," << theta_diff << "\n";
+    }
+
+    std::cout << std::scientific << "float_max_price_diff," << float_err << "\n"
+              << "mixed_max_price_diff," << mixed_err << "\n" << std::fixed;
+    // Mixed : à 1e-6 du double ; Float : erreur d'arrondi float seule
+    return mixed_err < 1e-6 && float_err < 1e-2;
+}
+
+// === TEST : PRICING BATCH (fichier projeté, sortie en flux) ===
+// CSV et binaire : mêmes prix que des solves individuels, ordre du fichier conservé,
+// contrat invalide ou ligne mal formée signalés (message entre guillemets) sans
+// interrompre le lot (débit : EDP_Bench, batch_pricer/)
+static bool checkBatchPricer() {
+    const std::size_t count = 200;
+    std::ostringstream csv, bin;
+    csv << "type,S0,K,T,r,sigma,S_max,N,M,theta\n# portefeuille de test\n";
+    edp::writeBinaryHeader(bin);
+    std::vector<edp::Contract> contracts;
+    for (std::size_t k = 0; k < count; ++k) {
+        edp::Contract c;
+        c.is_call = (k % 2 == 0);
+        c.S0 = 80.0 + 0.2 * static_cast<double>(k);
+        c.K = 100.0;
+        c.T = 0.5 + 0.005 * static_cast<double>(k);
+        c.r = 0.03;
+        c.sigma = 0.25;
+        c.S_max = 400.0;
+        c.N = 200;
+        c.M = 100;
+        contracts.push_back(c);
+        csv << (c.is_call ? "call" : "put") << "," << c.S0 << "," << c.K << "," << c.T << ","
+            << c.r << "," << c.sigma << "," << c.S_max << "," << c.N << "," << c.M << ",0.5\n";
+        edp::writeBinaryContract(bin, c);
+    }
+    csv << "put,100,-5,1,0.03,0.2\n";      // Strike invalide : ligne en erreur
+    csv << "call,100,abc,1,0.03,0.2\n";    // Lignes mal formées : erreur de la ligne,
+    csv << "forward,100,100,1,0.03,0.2\n"; // le lot continue
+    csv << "call,100,100\n";
+    csv << "call,100,100,1,0.03,0.2,400,200,100,0.5\n";
+    const std::size_t rejected = 4;
+
+    // Fichier réel, projeté en mémoire
+    const char* path = "batch_test_portfolio.csv";
+    {
+        std::ofstream file(path);
+        file << csv.str();
+    }
+    edp::BatchOptions options;
+    options.chunk_size = 64; // Plusieurs paquets
+    std::ostringstream out_csv;
+    edp::BatchStats stats;
+    {
+        edp::MappedFile file(path);
+        edp::ContractReader reader(file);
+        stats = edp::priceBatch(reader, out_csv, options);
+    }
+    std::remove(path);
+
+    std::string bin_data = bin.str();
+    edp::ContractReader bin_reader(bin_data.data(), bin_data.size());
+    std::ostringstream out_bin;
+    edp::BatchStats bin_stats = edp::priceBatch(bin_reader, out_bin, options);
+
+    // Relecture de la sortie CSV
+    std::istringstream lines(out_csv.str());
+    std::string line;
+    std::getline(lines, line); // En-tête
+    double max_diff = 0.0;
+    std::size_t rows = 0, quoted_errors = 0;
+    bool ordered = true, last_priced = false;
+    while (std::getline(lines, line)) {
+        std::size_t index = std::stoul(line.substr(0, line.find(',')));
+        ordered = ordered && (index == rows);
+        if (index < count) {
+            const edp::Contract& c = contracts[index];
+            double price = std::stod(line.substr(line.find(',') + 1));
+            edp::PDESolver solver(c.T, c.r, c.sigma, c.S_max, c.theta, c.N, c.M);
+            double ref = c.is_call ? solver.solve(edp::PayoffCall(c.K), c.S0).price
+                                   : solver.solve(edp::PayoffPut(c.K), c.S0).price;
+            max_diff = std::max(max_diff, std::fabs(price - ref) / std::max(1.0, ref));
+        } else if (index < count + rejected) {
+            // Message libre (virgules comprises) en un seul champ entre guillemets
+            std::string status = line.substr(line.find(",,,,,,,") + 7);
+            if (status.size() > 9 && status.compare(0, 9, "\"erreur: ") == 0 && status.back() == '"') {
+                ++quoted_errors;
+            }
+        } else {
+            last_priced = (line.size() > 3 && line.compare(line.size() - 3, 3, ",ok") == 0);
+        }
+        ++rows;
+    }
+
+    // Sortie binaire identique à la sortie CSV (hors lignes en erreur et suivantes)
+    std::string csv_body = out_csv.str();
+    csv_body = csv_body.substr(0, csv_body.find("\n" + std::to_string(count) + ",") + 1);
+    bool same_binary = (out_bin.str() == csv_body);
+
+    std::cout << "\nbatch_format,contracts,failed\n";
+    std::cout << "csv," << stats.contracts << "," << stats.failed << "\n";
+    std::cout << "binary," << bin_stats.contracts << "," << bin_stats.failed << "\n";
+    std::cout << "batch_max_rel_diff," << max_diff << "\n";
+
+    std::cout << "batch_quoted_errors," << quoted_errors << "\n";
+
+    return stats.contracts == count + rejected + 1 && stats.failed == rejected && quoted_errors == rejected
+        && last_priced && ordered && rows == count + rejected + 1 && max_diff < 1e-9
+        && bin_stats.contracts == count && same_binary;
+}
+
+// === TEST : MOTEUR DE PRICING CONCURRENT ===
+// Lot et contrats isolés identiques à un solveur neuf, erreurs par contrat
+// (débit par nombre de workers : EDP_Bench, engine/)
+static bool checkPricingEngine() {
+    // Portefeuille mélangé : trois grilles, volatilités et maturités variées
+    std::vector<edp::Contract> contracts;
+    for (std::size_t k = 0; k < 240; ++k) {
+        edp::Contract c;
+        c.is_call = (k % 3 != 0);
+        c.K = 100.0;
+        c.S0 = 70.0 + 0.25 * static_cast<double>(k % 200);
+        c.T = 0.25 + 0.01 * static_cast<double>(k % 50);
+        c.r = 0.02 + 0.01 * static_cast<double>(k % 2);
+        c.sigma = 0.15 + 0.05 * static_cast<double>(k % 4);
+        c.S_max = (k % 3 == 0) ? 400.0 : 500.0;
+        c.N = (k % 5 == 0) ? 160 : 200;
+        c.M = 80;
+        contracts.push_back(c);
+    }
+    auto reference = [](const edp::Contract& c) {
+        edp::PDESolver solver(c.T, c.r, c.sigma, c.S_max, c.theta, c.N, c.M);
+        solver.setComputeSensitivities(true);
+        return c.is_call ? solver.solve(edp::PayoffCall(c.K), c.S0) : solver.solve(edp::PayoffPut(c.K), c.S0);
+    };
+
+    // Lot complet et contrats isolés : identiques à un solveur neuf (reset sans effet de bord)
+    edp::PricingEngine engine(2, true);
+    std::vector<edp::PricingResults> batch = engine.priceAll(contracts);
+    auto f0 = engine.submit(contracts[7]);
+    auto f1 = engine.submit(contracts[12]);
+    edp::PricingResults r0 = f0.get(), r1 = f1.get();
+
+    double max_diff = 0.0;
+    for (std::size_t k = 0; k < contracts.size(); ++k) {
+        edp::PricingResults ref = reference(contracts[k]);
+        max_diff = std::max({max_diff, std::fabs(batch[k].price - ref.price), std::fabs(batch[k].delta - ref.delta),
+                             std::fabs(batch[k].vega - ref.vega)});
+    }
+    edp::PricingResults ref0 = reference(contracts[7]), ref1 = reference(contracts[12]);
+    max_diff = std::max({max_diff, std::fabs(r0.price - ref0.price), std::fabs(r1.price - ref1.price)});
+
+    // Erreurs : relancée par le future, par priceAll, ou rapportée par contrat
+    edp::Contract invalid = contracts[0];
+    invalid.sigma = -0.1;
+    bool future_throws = false, batch_throws = false;
+    try { (void)engine.submit(invalid).get(); } catch (const std::invalid_argument&) { future_throws = true; }
+    std::vector<edp::Contract> with_invalid = {contracts[1], invalid, contracts[2]};
+    try { (void)engine.priceAll(with_invalid); } catch (const std::invalid_argument&) { batch_throws = true; }
+    std::vector<edp::PricingResults> out(3);
+    std::vector<std::string> errors(3);
+    engine.priceAll(with_invalid.data(), with_invalid.size(), out.data(), errors.data());
+    bool errors_reported = errors[0].empty() && !errors[1].empty() && errors[2].empty()
+                        && out[2].price == batch[2].price;
+
+    // Grille automatique impossible (N < 6) : erreur de GridSizing, pas celle d'une grille vide
+    edp::Contract no_grid = contracts[0];
+    no_grid.domain_std = 5.0;
+    no_grid.N = 4;
+    auto isGridError = [](const std::string& what) { return what.find("GridSizing") != std::string::npos; };
+    bool grid_errors = false;
+    try { (void)engine.submit(no_grid).get(); } catch (const std::invalid_argument& e) { grid_errors = isGridError(e.what()); }
+    std::vector<edp::Contract> with_no_grid = {contracts[1], no_grid, contracts[2]};
+    try {
+        (void)engine.priceAll(with_no_grid);
+        grid_errors = false;
+    } catch (const std::invalid_argument& e) {
+        grid_errors = grid_errors && isGridError(e.what());
+    }
+    engine.priceAll(with_no_grid.data(), with_no_grid.size(), out.data(), errors.data());
+    grid_errors = grid_errors && errors[0].empty() && isGridError(errors[1]) && errors[2].empty()
+               && out[2].price == batch[2].price;
+
+    // Sans sensibilités (défaut) : mêmes prix, vega et rho nuls
+    edp::PricingEngine plain(1);
+    edp::PricingResults plain0 = plain.submit(contracts[7]).get();
+    bool opt_in = plain0.price == r0.price && plain0.vega == 0.0 && plain0.rho == 0.0 && r0.vega > 0.0;
+
+    // Parallélisme imbriqué : les cœurs sont partagés entre les solveurs des workers
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    edp::PricingEngine full(cores);
+    bool nested_bounded = full.getSolverThreads() == 1 && plain.getSolverThreads() == cores
+                       && engine.getSolverThreads() == std::max(1u, cores / 2);
+
+    // Autre nombre de workers (répartition et vols différents) : mêmes prix
+    edp::PricingEngine other(3);
+    std::vector<edp::PricingResults> res = other.priceAll(contracts);
+    for (std::size_t k = 0; k < contracts.size(); ++k) {
+        max_diff = std::max(max_diff, std::fabs(res[k].price - batch[k].price));
+    }
+    std::cout << "engine_max_abs_diff," << max_diff << "\n";
+
+    return max_diff == 0.0 && future_throws && batch_throws && errors_reported && grid_errors && opt_in
+        && nested_bounded;
+}
+
+// === TEST : STATISTIQUES DE SOLVE ===
+// Compteurs et temps par phase (EDP_ENABLE_STATS), cumul d'un moteur de pricing
+static bool checkSolveStats() {
+    edp::PDESolver solver(1.0, 0.05, 0.2, 400.0, 0.5, 200, 100);
+    solver.setComputeSensitivities(true);
+    edp::PayoffCall call(100.0);
+    edp::PricingResults first = solver.solve(call, 100.0);
+    edp::PricingResults second = solver.solve(call, 100.0);
+    edp::SolveStats one = solver.getSolveStats();
+
+    std::vector<const edp::Payoff*> payoffs(8, &call);
+    std::vector<double> spots(8, 100.0);
+    std::vector<edp::PricingResults> batch = solver.solve(payoffs, spots);
+    edp::SolveStats batched = solver.getSolveStats();
+    edp::SolveStats total = solver.getCumulativeStats();
+
+    // Cumul d'un moteur de pricing (agrégation des workers)
+    std::vector<edp::Contract> contracts(12);
+    for (std::size_t k = 0; k < contracts.size(); ++k) {
+        contracts[k].S0 = 90.0 + static_cast<double>(k);
+        contracts[k].K = 100.0;
+        contracts[k].T = 1.0;
+        contracts[k].r = 0.05;
+        contracts[k].sigma = 0.2;
+    }
+    edp::PricingEngine engine(2);
+    (void)engine.priceAll(contracts);
+    edp::SolveStats aggregated = engine.getSolveStats();
+
+    std::cout << "\nstats_enabled," << (edp::SolveStats::enabled ? 1 : 0) << "\n";
+
+    bool same = (first.price == second.price) && (batch[0].price == second.price);
+    if (!edp::SolveStats::enabled) {
+        // Compilé sans EDP_ENABLE_STATS : rien n'est collecté
+        return same && one.solves == 0 && one.totalNs() == 0 && total.solves == 0 && aggregated.solves == 0;
+    }
+
+    // Second solve identique : aucune réallocation, aucune factorisation (opérateur déjà en place)
+    bool counters = one.solves == 1 && one.steps == 100 && one.node_steps == 200 * 100
+                 && one.allocations == 0 && one.factorizations == 0
+                 && one.phaseNs(edp::SolvePhase::LinearSolve) > 0 && one.phaseNs(edp::SolvePhase::Rhs) > 0
+                 && one.phaseNs(edp::SolvePhase::Sensitivities) > 0 && one.nodeStepsPerSecond() > 0.0;
+    bool batch_counters = batched.node_steps == 8 * 200 * 100 && total.solves == 3;
+    bool engine_counters = aggregated.solves == contracts.size()
+                        && aggregated.node_steps == contracts.size() * 200 * 100;
+    return same && counters && batch_counters && engine_counters;
+}
+
+// === TEST : MOTEUR DE SCÉNARIOS ===
+// Grille de chocs spot x vol contre un solve indépendant par contrat et par choc de vol
+// (temps : EDP_Bench, scenario/)
+static bool checkScenarioEngine() {
+    // 48 contrats : deux maturités, deux grilles, calls et puts à strikes variés
+    std::vector<edp::Contract> portfolio;
+    for (std::size_t k = 0; k < 48; ++k) {
+        edp::Contract c;
+        c.is_call = (k % 2 == 0);
+        c.K = 80.0 + 5.0 * static_cast<double>(k % 8);
+        c.S0 = 100.0;
+        c.T = (k % 3 == 0) ? 0.5 : 1.0;
+        c.r = 0.03;
+        c.sigma = 0.2;
+        c.S_max = (k < 24) ? 400.0 : 500.0;
+        c.N = 200;
+        c.M = 100;
+        portfolio.push_back(c);
+    }
+    edp::ScenarioGrid grid;
+    grid.spot_shocks = {-0.2, -0.1, -0.05, 0.0, 0.05, 0.1, 0.2};
+    grid.vol_shocks = {-0.05, 0.0, 0.05, 0.1};
+
+    edp::ScenarioEngine engine;
+    edp::ScenarioResults res = engine.run(portfolio, grid);
+
+    // Référence : un solve indépendant par contrat et par choc de vol
+    // (déjà bien moins que contrats x scénarios), chocs de spot lus sur sa tranche
+    double max_diff = 0.0;
+    for (std::size_t k = 0; k < portfolio.size(); ++k) {
+        const edp::Contract& c = portfolio[k];
+        edp::PayoffCall call(c.K);
+        edp::PayoffPut put(c.K);
+        const edp::Payoff& payoff = c.is_call ? static_cast<const edp::Payoff&>(call) : put;
+        edp::PDESolver base_solver(c.T, c.r, c.sigma, c.S_max, c.theta, c.N, c.M);
+        double base = base_solver.solveSlice(payoff).evaluate(c.S0, edp::Interpolation::Linear).price;
+        max_diff = std::max(max_diff, std::fabs(res.base[k] - base));
+        for (std::size_t v = 0; v < grid.vol_shocks.size(); ++v) {
+            edp::PDESolver solver(c.T, c.r, c.sigma + grid.vol_shocks[v], c.S_max, c.theta, c.N, c.M);
+            edp::SolutionSlice slice = solver.solveSlice(payoff);
+            for (std::size_t s = 0; s < grid.spot_shocks.size(); ++s) {
+                double ref = slice.evaluate(c.S0 * (1.0 + grid.spot_shocks[s]), edp::Interpolation::Linear).price - base;
+                max_diff = std::max(max_diff, std::fabs(res(k, grid.index(v, s)) - ref));
+            }
+        }
+    }
+
+    // Scénario nul : P&L exactement nul ; chocs invalides refusés
+    bool zero_pnl = true;
+    for (std::size_t k = 0; k < portfolio.size(); ++k) zero_pnl = zero_pnl && res(k, grid.index(1, 3)) == 0.0;
+    bool rejected = false;
+    edp::ScenarioGrid bad = grid;
+    bad.vol_shocks.push_back(-0.3);
+    try { (void)engine.run(portfolio, bad); } catch (const std::invalid_argument&) { rejected = true; }
+
+    const std::size_t batch_solves = engine.getSolveCount();
+
+    // Grilles automatiques (domaine, tolérance) : même grille que gridFor, Rannacher compris
+    std::vector<edp::Contract> automatic(2, portfolio[1]);
+    automatic[0].domain_std = 5.0;
+    automatic[1].tolerance = 1e-2;
+    edp::ScenarioResults auto_res = engine.run(automatic, grid);
+    double auto_diff = 0.0;
+    for (std::size_t k = 0; k < automatic.size(); ++k) {
+        const edp::Contract& c = automatic[k];
+        const edp::GridChoice g = edp::gridFor(c);
+        edp::PDESolver solver(c.T, c.r, c.sigma, g.S_max, c.theta, g.N, g.M);
+        solver.reset(c.T, c.r, c.sigma, g.S_max, c.theta, g.N, g.M, g.S_min);
+        solver.setRannacherSteps(g.rannacher_steps);
+        edp::SolutionSlice slice = c.is_call ? solver.solveSlice(edp::PayoffCall(c.K))
+                                             : solver.solveSlice(edp::PayoffPut(c.K));
+        double ref = slice.evaluate(c.S0, edp::Interpolation::Linear).price;
+        auto_diff = std::max(auto_diff, std::fabs(auto_res.base[k] - ref));
+    }
+    std::cout << "scenario_automatic_grid_diff," << auto_diff << "\n";
+
+    // Prix de base identiques à ceux de PricingEngine (même interpolation) ;
+    // interpolation cubique sur option, prix de base compris
+    edp::PricingEngine pricer(1);
+    std::vector<edp::PricingResults> priced = pricer.priceAll(portfolio);
+    double engine_diff = 0.0;
+    for (std::size_t k = 0; k < portfolio.size(); ++k) {
+        engine_diff = std::max(engine_diff, std::fabs(res.base[k] - priced[k].price));
+    }
+    edp::ScenarioOptions cubic_options;
+    cubic_options.interpolation = edp::Interpolation::Cubic;
+    edp::ScenarioEngine cubic_engine(0, cubic_options);
+    edp::ScenarioResults cubic_res = cubic_engine.run(portfolio, grid);
+    const edp::Contract& c3 = portfolio[3];
+    edp::PDESolver c3_solver(c3.T, c3.r, c3.sigma, c3.S_max, c3.theta, c3.N, c3.M);
+    edp::SolutionSlice c3_slice = c3_solver.solveSlice(edp::PayoffPut(c3.K));
+    double cubic_diff = std::fabs(cubic_res.base[3] - c3_slice.evaluate(c3.S0, edp::Interpolation::Cubic).price);
+    std::cout << "scenario_base_vs_engine," << engine_diff << ",cubic_base_diff," << cubic_diff << "\n";
+
+    std::cout << "\nscenario_contracts,scenarios,batch_solves,single_solves,max_abs_diff\n";
+    std::cout << res.contracts << "," << res.scenarios << "," << batch_solves << ","
+              << portfolio.size() * (grid.vol_shocks.size() + 1) << "," << max_diff << "\n";
+
+    // Groupes : 2 grilles x 2 maturités, 4 niveaux de vol chacun
+    return max_diff < 1e-12 && zero_pnl && rejected && auto_diff < 1e-12 && batch_solves == 16
+        && res.pnl.size() == portfolio.size() * grid.size() && engine_diff < 1e-12 && cubic_diff < 1e-12;
+}
+
+// === TEST : VOLATILITÉ IMPLICITE PDE ===
+// Cotations issues de prix PDE à volatilité connue : inversion, solves par cotation
+// (temps : EDP_Bench, implied_vol/)
+static bool checkImpliedVol() {
+    // Cotations : prix PDE à une volatilité connue (smile), strikes et maturités variés
+    std::vector<edp::Contract> quotes;
+    std::vector<double> prices, true_sigma;
+    for (std::size_t k = 0; k < 96; ++k) {
+        edp::Contract c;
+        c.is_call = (k % 2 == 0);
+        c.S0 = 100.0;
+        c.K = 70.0 + 5.0 * static_cast<double>(k % 13);
+        c.T = (k % 3 == 0) ? 0.25 : ((k % 3 == 1) ? 1.0 : 2.0);
+        c.r = 0.03;
+        c.S_max = 400.0;
+        double sigma = 0.15 + 0.002 * std::fabs(c.K - 100.0) + 0.01 * static_cast<double>(k % 4);
+        edp::PDESolver solver(c.T, c.r, sigma, c.S_max, c.theta, c.N, c.M);
+        double price = c.is_call ? solver.solve(edp::PayoffCall(c.K), c.S0).price
+                                 : solver.solve(edp::PayoffPut(c.K), c.S0).price;
+        quotes.push_back(c);
+        prices.push_back(price);
+        true_sigma.push_back(sigma);
+    }
+    // Cotation impossible (call au-dessus du spot)
+    quotes.push_back(quotes[0]);
+    prices.push_back(150.0);
+
+    // Inversion analytique : aller-retour exact
+    double bs_roundtrip = std::fabs(edp::blackScholesImpliedVol(
+        false, edp::blackScholesPrice(false, 100.0, 110.0, 0.5, 0.03, 0.27), 100.0, 110.0, 0.5, 0.03) - 0.27);
+
+    edp::ImpliedVolSolver solver;
+    std::vector<edp::ImpliedVolResult> res = solver.solve(quotes, prices);
+
+    double max_err = 0.0;
+    std::size_t max_solves = 0;
+    bool all_converged = true;
+    for (std::size_t k = 0; k < true_sigma.size(); ++k) {
+        max_err = std::max(max_err, std::fabs(res[k].sigma - true_sigma[k]));
+        max_solves = std::max(max_solves, res[k].solves);
+        all_converged = all_converged && res[k].converged;
+    }
+    const edp::ImpliedVolResult& bad = res.back();
+    double per_quote = static_cast<double>(solver.getSolveCount()) / static_cast<double>(true_sigma.size());
+
+    // Domaine automatique : grille de gridFor, dimensionnée à la volatilité de Black-Scholes
+    std::vector<edp::Contract> auto_quotes = {quotes[4], quotes[5]};
+    std::vector<double> auto_prices = {prices[4], prices[5]};
+    for (edp::Contract& c : auto_quotes) c.domain_std = 5.0;
+    std::vector<edp::ImpliedVolResult> auto_res = solver.solve(auto_quotes, auto_prices);
+    double auto_err = 0.0;
+    for (std::size_t k = 0; k < auto_quotes.size(); ++k) {
+        edp::Contract c = auto_quotes[k];
+        c.sigma = edp::blackScholesImpliedVol(c.is_call, auto_prices[k], c.S0, c.K, c.T, c.r);
+        const edp::GridChoice g = edp::gridFor(c);
+        edp::PDESolver pde(c.T, c.r, auto_res[k].sigma, g.S_max, c.theta, g.N, g.M);
+        pde.reset(c.T, c.r, auto_res[k].sigma, g.S_max, c.theta, g.N, g.M, g.S_min);
+        pde.setRannacherSteps(g.rannacher_steps);
+        double model = c.is_call ? pde.solve(edp::PayoffCall(c.K), c.S0).price : pde.solve(edp::PayoffPut(c.K), c.S0).price;
+        auto_err = std::max(auto_err, auto_res[k].converged ? std::fabs(model - auto_prices[k]) : 1.0);
+    }
+    std::cout << "implied_vol_automatic_grid_price_error," << auto_err << "\n";
+
+    std::cout << "\nimplied_vol_quotes,solves_per_quote,max_solves,max_sigma_error,bs_roundtrip\n";
+    std::cout << true_sigma.size() << "," << per_quote << "," << max_solves << "," << max_err << ","
+              << bs_roundtrip << "\n";
+
+    // Moyenne visée : 2 à 3 solves ; les calls très dans la monnaie à 3 mois (biais de
+    // discrétisation fort en volatilité) en demandent un de plus
+    return all_converged && max_err < 1e-8 && per_quote <= 3.0 && max_solves <= 4 && bs_roundtrip < 1e-12
+        && !bad.converged && std::isnan(bad.sigma) && bad.solves == 0 && auto_err < 1e-7;
+}
+
+// === TEST : VARIABLE DE CONTRÔLE ANALYTIQUE ===
+// 1. Modèle = référence : prix de Black-Scholes exact même sur une grille grossière
+// 2. Structure par terme et volatilité locale : écart au prix convergé, PDE seule
+//    contre variable de contrôle, par taille de grille
+// 3. Noyau fermé par lot : identique aux formules ponctuelles
+static bool checkControlVariate() {
+    const double T = 1.0, S_max = 500.0, K = 100.0, S0 = 100.0;
+
+    // 1. Référence exacte (call et put), grille 40 x 20
+    edp::PDESolver coarse(T, 0.05, 0.20, S_max, 0.5, 40, 20);
+    double flat_err = std::max(
+        std::fabs(coarse.solveControlVariate(true, K, S0).price - edp::blackScholesPrice(true, S0, K, T, 0.05, 0.20)),
+        std::fabs(coarse.solveControlVariate(false, K, S0).price - edp::blackScholesPrice(false, S0, K, T, 0.05, 0.20)));
+
+    // 2a. Courbes r(t), sigma(t) : prix exact = Black-Scholes aux moyennes ;
+    //     référence de la variable de contrôle volontairement décalée de ces moyennes
+    edp::PiecewiseConstantCurve rates({0.25, 0.5, 1.0}, {0.02, 0.035, 0.05});
+    edp::PiecewiseConstantCurve vols({0.1, 0.4, 1.0}, {0.35, 0.25, 0.18});
+    const double r_avg = rates.integral(0.0, T) / T;
+    const double sigma_eff = std::sqrt((0.1 * 0.35 * 0.35 + 0.3 * 0.25 * 0.25 + 0.6 * 0.18 * 0.18) / T);
+    const double exact = edp::blackScholesPrice(true, S0, K, T, r_avg, sigma_eff);
+
+    std::cout << "\nmodel,N,M,plain_error,control_variate_error\n";
+    std::vector<double> plain_err, cv_err;
+    for (std::size_t N : {50, 100, 200, 800}) {
+        edp::PDESolver plain(T, 0.0, 0.0, S_max, 0.5, N, N / 2);
+        plain.setRateCurve(rates);
+        plain.setVolatilityCurve(vols);
+        edp::PDESolver cv(T, 0.03, 0.22, S_max, 0.5, N, N / 2);
+        cv.setRateCurve(rates);
+        cv.setVolatilityCurve(vols);
+        plain_err.push_back(std::fabs(plain.solve(edp::PayoffCall(K), S0).price - exact));
+        cv_err.push_back(std::fabs(cv.solveControlVariate(true, K, S0).price - exact));
+        std::cout << "term_structure," << N << "," << N / 2 << ","
+                  << plain_err.back() << "," << cv_err.back() << "\n";
+    }
+
+    // 2b. Smile de volatilité locale : prix de référence sur une grille fine
+    std::vector<double> spots = {50.0, 80.0, 100.0, 120.0, 300.0};
+    std::vector<double> smile_vols = {
+        0.35, 0.26, 0.20, 0.19, 0.22,
+        0.38, 0.28, 0.21, 0.20, 0.24};
+    edp::LocalVolSurface smile({0.5, 1.0}, spots, smile_vols);
+    edp::PDESolver fine(T, 0.03, 0.0, S_max, 0.5, 3200, 1600);
+    fine.setLocalVolatility(smile);
+    const double lv_exact = fine.solve(edp::PayoffPut(K), S0).price;
+    std::vector<double> lv_plain, lv_cv;
+    for (std::size_t N : {50, 100, 200}) {
+        edp::PDESolver plain(T, 0.03, 0.0, S_max, 0.5, N, N / 2);
+        plain.setLocalVolatility(smile);
+        edp::PDESolver cv(T, 0.03, 0.20, S_max, 0.5, N, N / 2);
+        cv.setLocalVolatility(smile);
+        lv_plain.push_back(std::fabs(plain.solve(edp::PayoffPut(K), S0).price - lv_exact));
+        lv_cv.push_back(std::fabs(cv.solveControlVariate(false, K, S0).price - lv_exact));
+        std::cout << "local_vol," << N << "," << N / 2 << "," << lv_plain.back() << "," << lv_cv.back() << "\n";
+    }
+
+    // 3. Noyau multi-spots contre formules ponctuelles (call et put, Delta)
+    std::vector<double> S(64), price(64), delta(64);
+    for (std::size_t i = 0; i < S.size(); ++i) S[i] = 40.0 + 2.5 * static_cast<double>(i);
+    double kernel_err = 0.0;
+    for (bool is_call : {true, false}) {
+        edp::blackScholesAtSpots(is_call, S.data(), nullptr, S.size(), K, 0.7, 0.04, 0.25, price.data(), delta.data());
+        for (std::size_t i = 0; i < S.size(); ++i) {
+            edp::PricingResults g = edp::blackScholesGreeks(is_call, S[i], K, 0.7, 0.04, 0.25);
+            kernel_err = std::max({kernel_err, std::fabs(price[i] - g.price), std::fabs(delta[i] - g.delta),
+                                   std::fabs(g.price - edp::blackScholesPrice(is_call, S[i], K, 0.7, 0.04, 0.25))});
+        }
+    }
+
+    // Puts loin hors de la monnaie (jusqu'à S_max) : précision relative conservée
+    for (std::size_t i = 0; i < S.size(); ++i) S[i] = 150.0 + 350.0 * static_cast<double>(i) / 63.0;
+    edp::blackScholesAtSpots(false, S.data(), nullptr, S.size(), K, 0.7, 0.04, 0.25, price.data(), delta.data());
+    double otm_rel_err = 0.0;
+    for (std::size_t i = 0; i < S.size(); ++i) {
+        double ref = edp::blackScholesPrice(false, S[i], K, 0.7, 0.04, 0.25);
+        otm_rel_err = std::max(otm_rel_err, ref > 0.0 ? std::fabs(price[i] - ref) / ref : std::fabs(price[i]));
+    }
+
+    bool american_rejected = false;
+    coarse.setExerciseStyle(edp::ExerciseStyle::American);
+    try {
+        (void)coarse.solveControlVariate(false, K, S0);
+    } catch (const std::logic_error&) {
+        american_rejected = true;
+    }
+
+    std::cout << "control_variate_flat_error," << flat_err << "\n";
+    std::cout << "bs_batch_kernel_error," << kernel_err << "\n";
+    std::cout << "bs_otm_put_rel_error," << std::scientific << otm_rel_err << std::fixed << "\n";
+
+    // Écart résiduel en O(h^2) régulier : la grille 200 x 100 fait mieux que la PDE seule en 800 x 400
+    bool term_better = true, lv_better = true;
+    for (std::size_t k = 0; k < cv_err.size(); ++k) term_better = term_better && cv_err[k] < 0.6 * plain_err[k];
+    for (std::size_t k = 0; k < lv_cv.size(); ++k) lv_better = lv_better && lv_cv[k] < 0.5 * lv_plain[k];
+    return flat_err < 1e-12 && kernel_err < 1e-12 && otm_rel_err < 1e-10 && american_rejected
+        && term_better && lv_better && cv_err[2] < plain_err.back();
+}
+
+// === TEST : DOMAINE ET GRILLE AUTOMATIQUES ===
+// Portefeuille mixte (maturités de 1 semaine à 5 ans, sigma de 8 % à 70 %) :
+// grille choisie pour une erreur visée, contre la plus petite grille fixe
+// ([S_max / 3000, S_max], S_max = 4K, N doublé, M = N / 2) qui atteint la même erreur.
+static bool checkAutomaticGrid() {
+    const double tolerance = 1e-2;
+    std::vector<edp::Contract> book;
+    for (double T : {0.02, 0.25, 1.0, 5.0}) {
+        for (double sigma : {0.08, 0.3, 0.7}) {
+            for (double moneyness : {0.9, 1.1}) {
+                edp::Contract c;
+                c.is_call = (book.size() % 2 == 0);
+                c.S0 = 100.0;
+                c.K = 100.0 * moneyness;
+                c.T = T;
+                c.r = 0.03;
+                c.sigma = sigma;
+                c.tolerance = tolerance;
+                book.push_back(c);
+            }
+        }
+    }
+
+    edp::PricingEngine engine(1, false);
+    std::vector<edp::PricingResults> res(book.size());
+    std::vector<edp::GridChoice> grids(book.size());
+    engine.priceAll(book.data(), book.size(), res.data(), nullptr, grids.data());
+
+    std::cout << "\nT,sigma,K,auto_N,auto_M,auto_error,fixed_N,fixed_M,fixed_error\n";
+    std::size_t auto_cost = 0, fixed_cost = 0, compared_cost = 0, fixed_unreachable = 0;
+    double max_err = 0.0;
+    bool strike_on_node = true;
+    for (std::size_t k = 0; k < book.size(); ++k) {
+        const edp::Contract& c = book[k];
+        const edp::GridChoice& g = grids[k];
+        const double exact = edp::blackScholesPrice(c.is_call, c.S0, c.K, c.T, c.r, c.sigma);
+        const double err = std::fabs(res[k].price - exact);
+        max_err = std::max(max_err, err);
+        auto_cost += g.nodeSteps();
+        double step = std::log(g.S_max / g.S_min) / static_cast<double>(g.N - 1);
+        double position = std::log(c.K / g.S_min) / step;
+        strike_on_node = strike_on_node && std::fabs(position - std::round(position)) < 1e-6;
+
+        // Grille fixe la plus petite (au plus 3 200 noeuds) qui tient la tolérance ;
+        // hors d'atteinte (troncature du domaine) : exclue de la comparaison des coûts
+        std::size_t N = 50;
+        double fixed_err = 0.0;
+        for (; ; N *= 2) {
+            edp::PDESolver fixed(c.T, c.r, c.sigma, 4.0 * c.K, 0.5, N, N / 2);
+            fixed_err = c.is_call ? std::fabs(fixed.solve(edp::PayoffCall(c.K), c.S0).price - exact)
+                                  : std::fabs(fixed.solve(edp::PayoffPut(c.K), c.S0).price - exact);
+            if (fixed_err <= tolerance || N >= 3200) break;
+        }
+        if (fixed_err <= tolerance) {
+            fixed_cost += N * (N / 2);
+            compared_cost += g.nodeSteps();
+        } else {
+            ++fixed_unreachable;
+        }
+        std::cout << c.T << "," << c.sigma << "," << c.K << "," << g.N << "," << g.M << "," << err << ","
+                  << N << "," << N / 2 << "," << fixed_err << "\n";
+    }
+
+    // Domaine seul (N et M donnés) : court terme, peu volatil
+    edp::Contract short_dated = book[0];
+    short_dated.tolerance = 0.0;
+    const double short_exact = edp::blackScholesPrice(true, short_dated.S0, short_dated.K, short_dated.T,
+                                                      short_dated.r, short_dated.sigma);
+    std::vector<edp::Contract> pair = {short_dated, short_dated};
+    pair[1].domain_std = 5.0;
+    std::vector<edp::PricingResults> pair_res = engine.priceAll(pair);
+    double fixed_domain_err = std::fabs(pair_res[0].price - short_exact);
+    double auto_domain_err = std::fabs(pair_res[1].price - short_exact);
+
+    // Tolérance tenue par le modèle d'erreur sur tout le portefeuille ; grille plafonnée
+    // (N_max, M_max trop petits) signalée au lieu d'annoncer la tolérance atteinte
+    bool achievable = true;
+    for (const edp::GridChoice& g : grids) {
+        achievable = achievable && g.achievable && g.estimated_error <= tolerance;
+    }
+    edp::GridSizingOptions capped;
+    capped.N_max = 100;
+    capped.M_max = 20;
+    edp::GridChoice capped_grid = edp::chooseGrid(100.0, 100.0, 1.0, 0.03, 0.2, 1e-4, capped);
+    bool capped_reported = !capped_grid.achievable && capped_grid.estimated_error > 1e-4
+                        && capped_grid.N == 100 && capped_grid.M == 20;
+    std::cout << "capped_grid_estimated_error," << capped_grid.estimated_error << "\n";
+
+    double ratio = static_cast<double>(fixed_cost) / static_cast<double>(compared_cost);
+    std::cout << "auto_node_steps," << auto_cost << "\n";
+    std::cout << "fixed_node_steps," << fixed_cost << "\n";
+    std::cout << "fixed_unreachable," << fixed_unreachable << "\n";
+    std::cout << "node_step_ratio," << ratio << "\n"; // Contrats atteints par les deux grilles
+    std::cout << "auto_max_error," << max_err << "\n";
+    std::cout << "short_dated_N200_error,fixed_domain," << fixed_domain_err << ",auto_domain," << auto_domain_err << "\n";
+
+    return max_err <= tolerance && strike_on_node && ratio > 3.0 && auto_domain_err < 0.1 * fixed_domain_err
+        && achievable && capped_reported;
+}
+
+// === TEST : SOLVEUR LINÉAIRE PARALLÈLE DANS LE PDE ===
+// Seuil abaissé pour forcer la partition : le prix doit rester celui du chemin séquentiel
+static bool checkParallelSolve() {
+    edp::PayoffPut payoff(100.0);
+
+    edp::PDESolver sequential(1.0, 0.05, 0.20, 500.0, 0.5, 2000, 200);
+    edp::PricingResults ref = sequential.solve(payoff, 100.0);
+
+    edp::PDESolver parallel(1.0, 0.05, 0.20, 500.0, 0.5, 2000, 200);
+    parallel.setParallelThreshold(0, 4);
+    edp::PricingResults res = parallel.solve(payoff, 100.0);
+
+    double diff = std::fabs(res.price - ref.price);
+    std::cout << "parallel_vs_sequential_diff," << diff << "\n";
+    return diff < 1e-10;
+}
+
+// === TEST : PAYOFF SPÉCIALISÉ À LA COMPILATION ===
+// solve<PayoffT> (type concret ou lambda) doit redonner le chemin polymorphe
+static bool checkStaticPayoffDispatch() {
+    edp::PDESolver solver(1.0, 0.05, 0.20, 500.0, 0.5, 200, 500);
+    edp::PayoffPut put(100.0);
+    const edp::Payoff& put_ref = put;
+
+    edp::PricingResults virtual_res = solver.solve(put_ref, 95.0);
+    edp::PricingResults static_res  = solver.solve(put, 95.0);
+    edp::PricingResults lambda_res  = solver.solve(
+        [](double spot) { return std::max(100.0 - spot, 0.0); }, 95.0);
+
+    double diff = std::max(std::fabs(virtual_res.price - static_res.price),
+                           std::fabs(virtual_res.price - lambda_res.price));
+    std::cout << "static_vs_virtual_payoff_diff," << diff << "\n";
+    return diff == 0.0;
+}
+
+// === TEST : ÉCHELLE DE SPOTS DEPUIS UN SEUL SOLVE ===
+// 50 spots : 50 solves individuels vs un solveSlice + une évaluation groupée
+// (temps : EDP_Bench, ladder/)
+static bool checkSpotLadder() {
+    const double K = 100.0, T = 1.0, r = 0.05, sigma = 0.20, S_max = 500.0;
+    const std::size_t N = 250, M = 1000;
+    edp::PayoffCall payoff(K);
+
+    std::vector<double> spots;
+    for (std::size_t k = 0; k < 50; ++k) spots.push_back(75.0 + static_cast<double>(k));
+
+    std::vector<edp::PricingResults> individual;
+    for (double spot : spots) {
+        edp::PDESolver solver(T, r, sigma, S_max, 0.5, N, M);
+        individual.push_back(solver.solve(payoff, spot));
+    }
+
+    edp::PDESolver solver(T, r, sigma, S_max, 0.5, N, M);
+    edp::SolutionSlice slice = solver.solveSlice(payoff);
+    std::vector<edp::PricingResults> linear, cubic, quintic;
+    slice.evaluate(spots, linear, edp::Interpolation::Linear);
+    slice.evaluate(spots, cubic, edp::Interpolation::Cubic);
+    slice.evaluate(spots, quintic, edp::Interpolation::Quintic);
+
+    double max_linear_diff = 0.0, max_cubic_err = 0.0, max_quintic_err = 0.0;
+    for (std::size_t k = 0; k < spots.size(); ++k) {
+        double bs = bs_call_price(spots[k], K, T, r, sigma);
+        max_linear_diff = std::max(max_linear_diff, std::fabs(linear[k].price - individual[k].price));
+        max_cubic_err   = std::max(max_cubic_err,   std::fabs(cubic[k].price - bs));
+        max_quintic_err = std::max(max_quintic_err, std::fabs(quintic[k].price - bs));
+    }
+
+    // Spots exactement sur un noeud : intervalle historique x[i] < x <= x[i+1]
+    // (Grecques au noeud j-1 pour un spot au noeud j), recherche linéaire de référence
+    const std::vector<double>& x = slice.nodes();
+    const std::vector<double>& V = slice.values();
+    const double dx = x[1] - x[0];
+    double max_on_node_diff = 0.0;
+    std::size_t on_node = 0;
+    for (std::size_t j = 2; j < N - 2; ++j) {
+        // Spot dont le logarithme retombe exactement sur le noeud
+        double spot = std::exp(x[j]);
+        for (int k = 0; k < 8 && std::log(spot) != x[j]; ++k) {
+            spot = std::nextafter(spot, std::log(spot) < x[j] ? 2.0 * spot : 0.0);
+        }
+        double target = std::log(spot);
+        if (target == x[j]) ++on_node;
+        std::size_t i = 1;
+        while (i < N - 2 && x[i + 1] < target) ++i;
+        double ratio = (target - x[i]) / dx;
+        double price = V[i] * (1.0 - ratio) + V[i + 1] * ratio;
+        double dV_dx = (V[i + 1] - V[i - 1]) / (2.0 * dx);
+        double d2V_dx2 = (V[i + 1] - 2.0 * V[i] + V[i - 1]) / (dx * dx);
+        double S_i = std::exp(x[i]);
+        edp::PricingResults res = slice.evaluate(spot, edp::Interpolation::Linear);
+        max_on_node_diff = std::max({max_on_node_diff, std::fabs(res.price - price),
+                                     std::fabs(res.delta - dV_dx / S_i),
+                                     std::fabs(res.gamma - (d2V_dx2 - dV_dx) / (S_i * S_i))});
+    }
+
+    std::cout << "ladder_spots,linear_vs_individual,cubic_vs_bs,quintic_vs_bs\n"
+              << spots.size() << "," << max_linear_diff << ","
+              << max_cubic_err << "," << max_quintic_err << "\n";
+
+    std::cout << "on_node_spots," << on_node << ",linear_vs_reference," << max_on_node_diff << "\n";
+
+    return max_linear_diff < 1e-12 && max_cubic_err < 2e-2 && max_quintic_err < 2e-2
+        && max_on_node_diff < 1e-12 && on_node > 0;
+}
+
+// === TEST : THETA, VEGA, RHO DEPUIS LA MÊME REMONTÉE ===
+// Theta par les deux dernières tranches, Vega/Rho par équations tangentes,
+// comparés aux Grecques analytiques de Black-Scholes
+static bool checkSensitivities() {
+    struct GreekCase { double S0, K, T, r, sigma; };
+    std::vector<GreekCase> cases = {
+        {100, 100, 1.0, 0.05, 0.20},
+        { 90, 100, 1.0, 0.05, 0.20},
+        {110, 100, 0.5, 0.03, 0.25},
+        {100, 120, 2.0, 0.02, 0.30}
+    };
+
+    std::cout << "S0,K,T,r,sigma,theta_BS,theta_PDE,vega_BS,vega_PDE,rho_BS,rho_PDE\n";
+    bool ok = true;
+    for (const auto& c : cases) {
+        edp::PDESolver solver(c.T, c.r, c.sigma, 5.0 * c.K, 0.5, 400, 1000);
+        solver.setComputeSensitivities(true);
+        edp::PricingResults pde = solver.solveSlice(edp::PayoffCall(c.K)).evaluate(c.S0);
+        edp::PricingResults bs  = bs_call_greeks(c.S0, c.K, c.T, c.r, c.sigma);
+
+        std::cout << c.S0 << "," << c.K << "," << c.T << "," << c.r << "," << c.sigma << ","
+                  << bs.theta << "," << pde.theta << ","
+                  << bs.vega << "," << pde.vega << ","
+                  << bs.rho << "," << pde.rho << "\n";
+
+        ok = ok && std::fabs(pde.theta - bs.theta) < 5e-3 * std::fabs(bs.theta)
+                && std::fabs(pde.vega  - bs.vega)  < 5e-3 * bs.vega
+                && std::fabs(pde.rho   - bs.rho)   < 5e-3 * bs.rho;
+    }
+    return ok;
+}
+
 // === FONCTION PRINCIPALE ===
 
 int main() {
@@ -106,5 +1474,113 @@ int main() {
             << err << "\n";
     }
 
+    if (!checkSteadyStateAllocations()) {
+        std::cerr << "Echec : solve() alloue en regime stable." << std::endl;
+        return 1;
+    }
+
+    if (!checkSensitivities()) {
+        std::cerr << "Echec : Theta/Vega/Rho PDE trop eloignes des Grecques analytiques." << std::endl;
+        return 1;
+    }
+
+    if (!checkSpotLadder()) {
+        std::cerr << "Echec : l'echelle de spots differe des solves individuels." << std::endl;
+        return 1;
+    }
+
+    if (!checkStaticPayoffDispatch()) {
+        std::cerr << "Echec : solve<PayoffT> differe du chemin polymorphe." << std::endl;
+        return 1;
+    }
+
+    if (!checkParallelSolve()) {
+        std::cerr << "Echec : le solveur parallele differe du solveur sequentiel." << std::endl;
+        return 1;
+    }
+
+    if (!checkNonUniformGrid()) {
+        std::cerr << "Echec : grille non uniforme" << std::endl;
+        return 1;
+    }
+
+    if (!checkToleranceMode()) {
+        std::cerr << "Echec : mode precision cible" << std::endl;
+        return 1;
+    }
+
+    if (!checkTimeStepping()) {
+        std::cerr << "Echec : demarrage de Rannacher / pas adaptatifs" << std::endl;
+        return 1;
+    }
+
+    if (!checkAmericanPut()) {
+        std::cerr << "Echec : put americain" << std::endl;
+        return 1;
+    }
+
+    if (!checkOperatorCache()) {
+        std::cerr << "Echec : cache des operateurs" << std::endl;
+        return 1;
+    }
+
+    if (!checkTermStructure()) {
+        std::cerr << "Echec : structure par terme" << std::endl;
+        return 1;
+    }
+
+    if (!checkLocalVolatility()) {
+        std::cerr << "Echec : volatilite locale" << std::endl;
+        return 1;
+    }
+
+    if (!checkHestonADI()) {
+        std::cerr << "Echec : moteur ADI de Heston" << std::endl;
+        return 1;
+    }
+
+    if (!checkMixedPrecision()) {
+        std::cerr << "Echec : precision mixte" << std::endl;
+        return 1;
+    }
+
+    if (!checkBatchPricer()) {
+        std::cerr << "Echec : pricing batch" << std::endl;
+        return 1;
+    }
+
+    if (!checkPricingEngine()) {
+        std::cerr << "Echec : moteur de pricing concurrent" << std::endl;
+        return 1;
+    }
+
+    if (!checkSolveStats()) {
+        std::cerr << "Echec : statistiques de solve" << std::endl;
+        return 1;
+    }
+
+    if (!checkScenarioEngine()) {
+        std::cerr << "Echec : moteur de scenarios" << std::endl;
+        return 1;
+    }
+
+    if (!checkImpliedVol()) {
+        std::cerr << "Echec : volatilite implicite PDE" << std::endl;
+        return 1;
+    }
+
+    if (!checkControlVariate()) {
+        std::cerr << "Echec : variable de controle analytique" << std::endl;
+        return 1;
+    }
+    if (!checkAutomaticGrid()) {
+        std::cerr << "Echec : domaine et grille automatiques" << std::endl;
+        return 1;
+    }
+    if (!checkBatchedSolve()) {
+        std::cerr << "Echec : le solve par lot differe des solves individuels." << std::endl;
+        return 1;
+    }
+
     return 0;
 }
\ No newline at end of file